@@ -22,6 +22,7 @@ pub struct FleetApplication {
     persistence: FilePersistence,
     launcher: LauncherImpl,
     orchestrator: PipelineOrchestrator,
+    update_watch: Option<crate::update_watch::UpdateWatcher>,
     auto_local_checked: HashSet<ProfileId>,
 
     msg_rx: mpsc::Receiver<DomainEvent>,
@@ -38,14 +39,23 @@ impl FleetApplication {
         let (msg_tx, msg_rx) = mpsc::channel(100);
         let client =
             fleet_infra::net::default_http_client().unwrap_or_else(|_| reqwest::Client::new());
-        let engine = fleet_pipeline::default_engine(client);
+        // The app engine lives for the whole session, so watcher-backed local
+        // state pays off: repeat integrity checks of a profile only re-scan
+        // the mods that changed since the previous check.
+        let engine = fleet_pipeline::watched_engine(client);
         let engine = std::sync::Arc::new(engine);
 
+        // Best-effort background freshness probing; if the watcher thread
+        // cannot start, the app degrades to user-triggered checks only.
+        let update_watch =
+            crate::update_watch::UpdateWatcher::start(engine.clone(), msg_tx.clone()).ok();
+
         Self {
             state: AppState::default(),
             persistence: FilePersistence::new(),
             launcher: LauncherImpl::new(),
             orchestrator: PipelineOrchestrator::new(engine, msg_tx.clone()),
+            update_watch,
             auto_local_checked: HashSet::new(),
             msg_rx,
             msg_tx,
@@ -69,9 +79,16 @@ impl FleetApplication {
         if let Some(id) = self.state.selected_profile_id.clone() {
             self.ensure_local_integrity_checked(&id);
         }
+        self.sync_update_watch_targets();
         Ok(())
     }
 
+    fn sync_update_watch_targets(&self) {
+        if let Some(watch) = &self.update_watch {
+            watch.set_profiles(self.state.profiles.clone());
+        }
+    }
+
     // --- Actions ---
 
     pub fn check_for_updates(&mut self, profile_id: ProfileId) -> anyhow::Result<()> {
@@ -149,10 +166,22 @@ impl FleetApplication {
 
         let run_id: PipelineRunId = uuid::Uuid::new_v4();
         self.state.pipeline.run_id = Some(run_id);
-        if let Err(e) =
-            self.orchestrator
-                .start_sync(profile, plan, self.state.settings.clone(), run_id)
-        {
+        // Every other profile's root is a dedup source: files they already
+        // hold verified are hardlinked instead of re-downloaded.
+        let dedup_roots: Vec<camino::Utf8PathBuf> = self
+            .state
+            .profiles
+            .iter()
+            .filter(|p| p.id != profile.id)
+            .map(|p| camino::Utf8PathBuf::from(p.local_path.clone()))
+            .collect();
+        if let Err(e) = self.orchestrator.start_sync(
+            profile,
+            plan,
+            self.state.settings.clone(),
+            run_id,
+            dedup_roots,
+        ) {
             self.state = reduce(self.state.clone(), DomainEvent::UserError(e.to_string()));
             return Err(e);
         }
@@ -243,7 +272,24 @@ impl FleetApplication {
                     continue;
                 }
             }
+            let escalate = match &ev {
+                DomainEvent::RemoteProbed {
+                    profile_id,
+                    changed: true,
+                } => Some(profile_id.clone()),
+                _ => None,
+            };
             self.state = reduce(self.state.clone(), ev);
+            // A changed probe escalates to the full remote check (fetch +
+            // scan + diff); unchanged probes stop here, so the steady state
+            // never loads the baseline or scans. Never preempt a pipeline
+            // the user already has running - the probe stays Changed until
+            // a full check persists a fresh summary, so we retry next tick.
+            if let Some(profile_id) = escalate {
+                if !self.is_pipeline_running() {
+                    let _ = self.check_for_updates(profile_id);
+                }
+            }
         }
     }
 
@@ -298,6 +344,7 @@ impl FleetApplication {
                 self.state.clone(),
                 DomainEvent::RouteChanged(Route::ProfileHub),
             );
+            self.sync_update_watch_targets();
 
             let profiles_snapshot = self.state.profiles.clone();
             let repo_url = draft.repo_url.clone();
@@ -349,6 +396,7 @@ impl FleetApplication {
     pub fn delete_profile(&mut self, id: ProfileId) -> anyhow::Result<()> {
         self.state.profiles.retain(|p| p.id != id);
         self.persistence.save_profiles(&self.state.profiles)?;
+        self.sync_update_watch_targets();
         Ok(())
     }
     pub fn update_settings(&mut self, s: AppSettings) -> anyhow::Result<()> {
@@ -1,4 +1,4 @@
-use crate::domain::{AppSettings, Profile, Route};
+use crate::domain::{AppSettings, Profile, ProfileId, Route};
 use crate::pipeline::{PipelineRunEvent, PipelineRunId};
 
 #[derive(Debug, Clone)]
@@ -27,6 +27,14 @@ pub enum DomainEvent {
         ev: PipelineRunEvent,
     },
 
+    // Background update watch: cheap freshness probe result for a profile.
+    // `changed` means repo.json moved upstream (or the local mod set did)
+    // since the last full check.
+    RemoteProbed {
+        profile_id: ProfileId,
+        changed: bool,
+    },
+
     // User-visible errors
     UserError(String),
 }
@@ -41,6 +41,19 @@ pub fn reduce(mut state: AppState, ev: DomainEvent) -> AppState {
 
         DomainEvent::PipelineEvent { run_id: _, ev } => apply_pipeline_event(&mut state, ev),
 
+        DomainEvent::RemoteProbed {
+            profile_id,
+            changed,
+        } => {
+            let entry = state.remote_watch.entry(profile_id).or_default();
+            entry.checked_at = Some(Utc::now());
+            // An unchanged probe must not clear a pending update: it only
+            // says nothing moved since the last full check saw it.
+            if changed {
+                entry.update_available = true;
+            }
+        }
+
         DomainEvent::UserError(msg) => {
             state.pipeline.error = Some(msg);
         }
@@ -102,6 +115,15 @@ fn apply_pipeline_event(state: &mut AppState, ev: PipelineRunEvent) {
             diff_stats,
             existing_mods,
         } => {
+            // A full check is the authoritative freshness verdict: an empty
+            // plan means in sync, anything else is an actionable update.
+            if let Some(active_id) = &state.pipeline.active_profile_id {
+                let entry = state.remote_watch.entry(active_id.clone()).or_default();
+                entry.checked_at = Some(Utc::now());
+                entry.update_available = !(plan.downloads.is_empty()
+                    && plan.deletes.is_empty()
+                    && plan.renames.is_empty());
+            }
             state.last_plan = Some(plan);
             state.pipeline.stats.diff = Some(diff_stats);
             state.pipeline.plan_existing_mods = Some(existing_mods);
@@ -119,6 +141,9 @@ fn apply_pipeline_event(state: &mut AppState, ev: PipelineRunEvent) {
                 if let Some(profile) = state.profiles.iter_mut().find(|p| &p.id == active_id) {
                     profile.last_synced = Some(Utc::now());
                 }
+                let entry = state.remote_watch.entry(active_id.clone()).or_default();
+                entry.checked_at = Some(Utc::now());
+                entry.update_available = false;
             }
         }
 
@@ -77,6 +77,16 @@ pub enum Route {
     Settings,
 }
 
+/// Dashboard-facing result of the background update watch for one profile.
+#[derive(Debug, Clone, Default)]
+pub struct RemoteWatchStatus {
+    /// When the repo was last probed (or fully checked).
+    pub checked_at: Option<DateTime<Utc>>,
+    /// Set once upstream or local drift is seen and cleared when a check
+    /// produces an empty plan or a sync completes.
+    pub update_available: bool,
+}
+
 #[derive(Debug, Clone)]
 pub enum BootState {
     Loading,
@@ -99,6 +109,7 @@ pub struct AppState {
 
     pub pipeline: PipelineState,
     pub last_plan: Option<fleet_core::SyncPlan>,
+    pub remote_watch: std::collections::HashMap<ProfileId, RemoteWatchStatus>,
 }
 
 impl Default for AppState {
@@ -114,6 +125,7 @@ impl Default for AppState {
             editor_draft: None,
             pipeline: PipelineState::idle(),
             last_plan: None,
+            remote_watch: std::collections::HashMap::new(),
         }
     }
 }
@@ -8,15 +8,17 @@ pub mod orchestrator;
 pub mod persistence;
 pub mod pipeline;
 pub mod ports;
+pub mod update_watch;
 pub mod viewmodel;
 
 pub use app::FleetApplication;
 pub use app_core::*;
-pub use domain::{AppSettings, AppState, BootState, Profile, ProfileId, Route};
+pub use domain::{AppSettings, AppState, BootState, Profile, ProfileId, RemoteWatchStatus, Route};
 pub use kernel::AppKernel;
 pub use pipeline::{
     PipelineRunEvent, PipelineRunId, PipelineState, PipelineStats, PipelineStep, StepStatus,
     TransferProgressVm,
 };
 pub use ports::*;
+pub use update_watch::UpdateWatcher;
 pub use viewmodel::*;
@@ -191,6 +191,9 @@ impl PipelineOrchestrator {
                         max_threads: settings.max_threads,
                         rate_limit_bytes: None,
                         cache_root: None,
+                        mirror_urls: Vec::new(),
+                        progress_table: None,
+                        dedup_roots: Vec::new(),
                     };
 
                     let req = SyncRequest {
@@ -453,6 +456,7 @@ impl PipelineOrchestrator {
         plan: SyncPlan,
         settings: AppSettings,
         run_id: PipelineRunId,
+        dedup_roots: Vec<camino::Utf8PathBuf>,
     ) -> anyhow::Result<()> {
         self.cancel();
         let token = CancellationToken::new();
@@ -487,6 +491,12 @@ impl PipelineOrchestrator {
                         })
                         .await;
 
+                    // Byte progress flows through a shared counter table the
+                    // ticker below samples; the event channel only carries
+                    // Started/Completed, so twenty concurrent downloads no
+                    // longer wake this loop per progress chunk.
+                    let progress_table =
+                        Arc::new(fleet_infra::net::ProgressTable::default());
                     let req = SyncRequest {
                         repo_url: profile.repo_url.clone(),
                         local_root: camino::Utf8PathBuf::from(profile.local_path.clone()),
@@ -499,6 +509,9 @@ impl PipelineOrchestrator {
                                 None
                             },
                             cache_root: None,
+                            mirror_urls: Vec::new(),
+                            progress_table: Some(progress_table.clone()),
+                            dedup_roots,
                         },
                         profile_id: Some(profile.id.clone()),
                     };
@@ -515,8 +528,7 @@ impl PipelineOrchestrator {
                         .await;
 
                     let (prog_tx, mut prog_rx) = mpsc::channel(100);
-                    let mut tracker = ProgressTracker::new(&plan);
-                    let mut latest: Option<TransferSnapshot> = None;
+                    let mut tracker = ProgressTracker::with_table(&plan, progress_table);
                     let mut ticker = interval(Duration::from_millis(100));
 
                     let work_fut = engine.execute_with_plan(&req, plan.clone(), Some(prog_tx));
@@ -530,9 +542,8 @@ impl PipelineOrchestrator {
                                 return;
                             }
                             res = &mut work_fut => {
-                                if let Some(snap) = latest.take() {
-                                    let _ = tx.send(DomainEvent::PipelineEvent { run_id, ev: PipelineRunEvent::TransferProgress { snapshot: snap } }).await;
-                                }
+                                let snap = tracker.get_snapshot();
+                                let _ = tx.send(DomainEvent::PipelineEvent { run_id, ev: PipelineRunEvent::TransferProgress { snapshot: snap } }).await;
                                 match res {
                                     Ok(_r) => {
                                         let _ = tx.send(DomainEvent::PipelineEvent { run_id, ev: PipelineRunEvent::Completed }).await;
@@ -544,15 +555,15 @@ impl PipelineOrchestrator {
                                 break;
                             }
                             maybe_ev = prog_rx.recv() => {
+                                // Only Started/Completed transitions arrive
+                                // here; bytes are sampled from the table.
                                 if let Some(ev) = maybe_ev {
                                     tracker.update(ev);
-                                    latest = Some(tracker.get_snapshot());
                                 }
                             }
                             _ = ticker.tick() => {
-                                if let Some(snap) = latest.clone() {
-                                    let _ = tx.try_send(DomainEvent::PipelineEvent { run_id, ev: PipelineRunEvent::TransferProgress { snapshot: snap } });
-                                }
+                                let snap = tracker.get_snapshot();
+                                let _ = tx.try_send(DomainEvent::PipelineEvent { run_id, ev: PipelineRunEvent::TransferProgress { snapshot: snap } });
                             }
                         }
                     }
@@ -565,6 +576,9 @@ impl PipelineOrchestrator {
                             max_threads: settings.max_threads,
                             rate_limit_bytes: None,
                             cache_root: None,
+                            mirror_urls: Vec::new(),
+                            progress_table: None,
+                            dedup_roots: Vec::new(),
                         },
                         profile_id: Some(profile.id.clone()),
                     };
@@ -0,0 +1,162 @@
+//! Background update watcher.
+//!
+//! Polls every watched profile on an interval using
+//! [`DefaultSyncEngine::probe_remote_freshness`] - one HEAD request compared
+//! against the persisted repo summary, plus one stat of the profile root.
+//! When neither has moved, the probe only refreshes the dashboard's
+//! "checked at" status; the baseline manifest is never loaded and no scan
+//! runs. Only an actual change emits a `changed` probe, which the
+//! application escalates to the full remote update check.
+
+use std::collections::HashMap;
+use std::sync::Arc;
+use std::time::Duration;
+
+use anyhow::Context;
+use tokio::sync::{mpsc, watch};
+use tokio_util::sync::CancellationToken;
+
+use crate::app_core::DomainEvent;
+use crate::domain::Profile;
+
+use fleet_pipeline::{DefaultSyncEngine, RemoteFreshness};
+
+/// How often each watched profile is probed. Each probe is one HEAD request
+/// and one stat, so steady-state cost is negligible at this cadence.
+const POLL_INTERVAL: Duration = Duration::from_secs(60);
+
+pub struct UpdateWatcher {
+    profiles_tx: watch::Sender<Vec<Profile>>,
+    cancel: CancellationToken,
+}
+
+/// Per-profile state carried between ticks.
+struct ProfileMemo {
+    /// Root directory mtime (millis) seen on the previous tick. The top-level
+    /// mtime moves when mods are added or removed, which is the cheap signal
+    /// that the persisted local summary may no longer describe the tree.
+    local_stamp: Option<u64>,
+}
+
+impl UpdateWatcher {
+    pub fn start(
+        engine: Arc<DefaultSyncEngine>,
+        tx: mpsc::Sender<DomainEvent>,
+    ) -> anyhow::Result<Self> {
+        Self::start_with_interval(engine, tx, POLL_INTERVAL)
+    }
+
+    /// Like [`start`](Self::start) with an explicit poll interval; exists so
+    /// tests do not have to wait out the production cadence.
+    pub fn start_with_interval(
+        engine: Arc<DefaultSyncEngine>,
+        tx: mpsc::Sender<DomainEvent>,
+        poll_interval: Duration,
+    ) -> anyhow::Result<Self> {
+        let (profiles_tx, mut profiles_rx) = watch::channel(Vec::new());
+        let cancel = CancellationToken::new();
+        let token = cancel.clone();
+
+        std::thread::Builder::new()
+            .name("fleet-update-watch".into())
+            .spawn(move || {
+                let rt = match crate::async_runtime::runtime() {
+                    Ok(rt) => rt,
+                    // Best-effort service: without a runtime the app just
+                    // falls back to user-triggered checks.
+                    Err(_) => return,
+                };
+
+                rt.block_on(async move {
+                    let mut ticker = tokio::time::interval(poll_interval);
+                    ticker.set_missed_tick_behavior(tokio::time::MissedTickBehavior::Delay);
+                    let mut memos: HashMap<String, ProfileMemo> = HashMap::new();
+
+                    loop {
+                        tokio::select! {
+                            _ = token.cancelled() => break,
+                            _ = ticker.tick() => {}
+                            // A changed profile set (boot, add, delete) is
+                            // probed right away instead of waiting out the
+                            // current interval.
+                            res = profiles_rx.changed() => {
+                                if res.is_err() {
+                                    break;
+                                }
+                            }
+                        }
+
+                        let profiles: Vec<Profile> = profiles_rx.borrow().clone();
+                        memos.retain(|id, _| profiles.iter().any(|p| &p.id == id));
+
+                        for profile in profiles {
+                            if token.is_cancelled() {
+                                break;
+                            }
+                            probe_profile(&engine, &tx, &mut memos, &profile).await;
+                        }
+                    }
+                });
+            })
+            .context("Failed to spawn update watcher thread")?;
+
+        Ok(Self {
+            profiles_tx,
+            cancel,
+        })
+    }
+
+    /// Replaces the watched profile set; called whenever profiles are loaded,
+    /// saved, or deleted.
+    pub fn set_profiles(&self, profiles: Vec<Profile>) {
+        let _ = self.profiles_tx.send(profiles);
+    }
+}
+
+impl Drop for UpdateWatcher {
+    fn drop(&mut self) {
+        self.cancel.cancel();
+    }
+}
+
+async fn probe_profile(
+    engine: &DefaultSyncEngine,
+    tx: &mpsc::Sender<DomainEvent>,
+    memos: &mut HashMap<String, ProfileMemo>,
+    profile: &Profile,
+) {
+    let freshness = engine
+        .probe_remote_freshness(&profile.repo_url, &profile.id)
+        .await;
+    let local_stamp = root_dir_stamp(&profile.local_path);
+
+    let memo = memos
+        .entry(profile.id.clone())
+        .or_insert(ProfileMemo { local_stamp });
+    let local_changed =
+        memo.local_stamp.is_some() && local_stamp.is_some() && memo.local_stamp != local_stamp;
+    memo.local_stamp = local_stamp;
+
+    let changed = local_changed || freshness == RemoteFreshness::Changed;
+    if !changed && freshness == RemoteFreshness::Unknown {
+        // Nothing moved locally, but the server gave no freshness signal:
+        // stay silent rather than vouch for a state we cannot verify.
+        return;
+    }
+
+    // Probes are advisory like progress updates; drop them rather than block
+    // the watcher when the UI is not draining events.
+    let _ = tx.try_send(DomainEvent::RemoteProbed {
+        profile_id: profile.id.clone(),
+        changed,
+    });
+}
+
+fn root_dir_stamp(local_path: &str) -> Option<u64> {
+    let meta = std::fs::metadata(local_path).ok()?;
+    let modified = meta.modified().ok()?;
+    modified
+        .duration_since(std::time::UNIX_EPOCH)
+        .ok()
+        .map(|d| d.as_millis() as u64)
+}
@@ -0,0 +1,76 @@
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use fleet_pipeline::sync::engine::build_fast_plan;
+use fleet_pipeline::sync::storage::{LocalFileSummary, LocalManifestSummary};
+use std::hint::black_box;
+
+/// Deterministic xorshift; keeps generated summaries stable across runs
+/// without a rand dependency.
+struct Rng(u64);
+
+impl Rng {
+    fn next(&mut self) -> u64 {
+        self.0 ^= self.0 << 13;
+        self.0 ^= self.0 >> 7;
+        self.0 ^= self.0 << 17;
+        self.0
+    }
+}
+
+fn synth_summaries(mods: usize, files_per_mod: usize) -> Vec<LocalManifestSummary> {
+    let mut rng = Rng(0xFA57);
+    (0..mods)
+        .map(|m| LocalManifestSummary {
+            mod_name: format!("@synthetic_mod_{m}"),
+            files: (0..files_per_mod)
+                .map(|f| LocalFileSummary {
+                    rel_path: format!("addons/file_{f}.pbo"),
+                    mtime: 1_700_000_000 + (rng.next() % 10_000),
+                    size: 1_000_000 + rng.next() % 20_000_000,
+                    checksum: format!("{:032X}", rng.next()),
+                })
+                .collect(),
+        })
+        .collect()
+}
+
+/// Touches roughly one file in `dirty_ratio`, the shape of a small upstream
+/// update landing on a mostly-clean tree.
+fn perturb(expected: &[LocalManifestSummary], dirty_ratio: usize) -> Vec<LocalManifestSummary> {
+    let mut rng = Rng(0xD1FF);
+    let mut current = expected.to_vec();
+    for m in &mut current {
+        for f in &mut m.files {
+            if rng.next() as usize % dirty_ratio == 0 {
+                f.mtime += 1;
+            }
+        }
+    }
+    current
+}
+
+fn bench_build_fast_plan(c: &mut Criterion) {
+    let mut group = c.benchmark_group("build_fast_plan");
+    group.sample_size(10);
+
+    for &total_files in &[10_000usize, 100_000, 500_000] {
+        let mods = total_files / 1_000;
+        let expected = synth_summaries(mods, 1_000);
+        let dirty = perturb(&expected, 50);
+
+        group.throughput(Throughput::Elements(total_files as u64));
+        group.bench_with_input(
+            BenchmarkId::new("clean", total_files),
+            &expected,
+            |b, expected| b.iter(|| black_box(build_fast_plan(expected, expected))),
+        );
+        group.bench_with_input(
+            BenchmarkId::new("dirty_2pct", total_files),
+            &(&expected, &dirty),
+            |b, (expected, dirty)| b.iter(|| black_box(build_fast_plan(expected, dirty))),
+        );
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_build_fast_plan);
+criterion_main!(benches);
@@ -14,11 +14,13 @@ use crate::sync::storage::{
 use crate::sync::{SyncError, SyncMode, SyncOptions, SyncRequest, SyncResult, SyncStats};
 use fleet_core::path_utils::FleetPath;
 use fleet_persistence::{
-    CacheDeleteRecord, CacheRenameRecord, CacheUpsertRecord, FleetDataStore, RedbFleetDataStore,
+    CacheDeleteRecord, CacheRenameRecord, CacheUpsertRecord, CacheWriteBehind, FleetDataStore,
+    RedbFleetDataStore,
 };
 use fleet_scanner::Scanner;
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
 use std::sync::Arc;
+use std::time::Instant;
 
 pub struct DefaultSyncEngine {
     remote: Box<dyn RemoteStateProvider>,
@@ -28,6 +30,22 @@ pub struct DefaultSyncEngine {
     repo_summary_store: Arc<dyn RepoSummaryStore>,
 }
 
+/// Outcome of [`DefaultSyncEngine::probe_remote_freshness`]: a single HEAD
+/// request compared against the persisted [`RepoSummary`], with no repo.json
+/// download, no baseline load, and no local scan.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum RemoteFreshness {
+    /// The server's Last-Modified matches the summary persisted by the last
+    /// full fetch; repo.json has not changed upstream.
+    Unchanged,
+    /// Upstream repo.json differs from what we last fetched (or we have never
+    /// fetched it for this profile); a full check is warranted.
+    Changed,
+    /// The server did not expose a usable Last-Modified (or the HEAD request
+    /// failed), so freshness cannot be decided cheaply.
+    Unknown,
+}
+
 impl DefaultSyncEngine {
     pub fn new(client: reqwest::Client) -> Self {
         let remote = Box::new(HttpRemoteStateProvider::new(client.clone()));
@@ -44,6 +62,27 @@ impl DefaultSyncEngine {
         }
     }
 
+    /// Like [`new`](Self::new), but local state comes from a
+    /// [`WatchedLocalStateProvider`](crate::sync::local::WatchedLocalStateProvider)
+    /// that keeps a filesystem watcher per checked root. Meant for processes
+    /// that live long enough to amortize the first full scan.
+    pub fn new_watched(client: reqwest::Client) -> Self {
+        let remote = Box::new(HttpRemoteStateProvider::new(client.clone()));
+        let fleet_data: Arc<dyn FleetDataStore> = Arc::new(RedbFleetDataStore);
+        let local = Box::new(crate::sync::local::WatchedLocalStateProvider::new(
+            fleet_data.clone(),
+        ));
+        let executor = Box::new(DefaultPlanExecutor::new(client));
+        let repo_summary_store: Arc<dyn RepoSummaryStore> = Arc::new(FileRepoSummaryStore::new());
+        Self {
+            remote,
+            local,
+            executor,
+            fleet_data,
+            repo_summary_store,
+        }
+    }
+
     pub fn with_components(
         remote: Box<dyn RemoteStateProvider>,
         local: Box<dyn LocalStateProvider>,
@@ -111,6 +150,7 @@ impl DefaultSyncEngine {
             .clone()
             .ok_or_else(|| SyncError::Remote("repository unavailable".into()))?
             .into();
+        let mirrors = repository.mirrors.clone();
         let base = crate::sync::remote::normalize_repo_base(&req.repo_url)?;
 
         let mut mods = Vec::new();
@@ -174,9 +214,35 @@ impl DefaultSyncEngine {
                 mods,
             },
             stats,
+            mirrors,
         })
     }
 
+    /// Cheap freshness probe for background update checks: one HEAD request
+    /// against repo.json, compared to the [`RepoSummary`] persisted for
+    /// `profile_id` by the last full fetch. Deliberately infallible so pollers
+    /// can run it on a timer without error plumbing - anything inconclusive
+    /// comes back as [`RemoteFreshness::Unknown`].
+    pub async fn probe_remote_freshness(
+        &self,
+        repo_url: &str,
+        profile_id: &str,
+    ) -> RemoteFreshness {
+        let remote_mtime = match self.remote.head_repo_json_mtime(repo_url).await {
+            Ok(Some(m)) => m,
+            _ => return RemoteFreshness::Unknown,
+        };
+
+        match self.repo_summary_store.load_repo_summary(profile_id) {
+            Ok(Some(cached)) if cached.last_modified.as_deref() == Some(remote_mtime.as_str()) => {
+                RemoteFreshness::Unchanged
+            }
+            // No summary yet (never fetched) or a load error both mean the
+            // heavy path has to run anyway; report Changed conservatively.
+            _ => RemoteFreshness::Changed,
+        }
+    }
+
     /// Validate that the repository URL is reachable and returns a parsable repo.json.
     pub async fn validate_repo_url(&self, repo_url: &str) -> Result<(), SyncError> {
         let _ = self.remote.fetch_repo_json(repo_url).await?;
@@ -239,24 +305,305 @@ impl DefaultSyncEngine {
     }
 
     /// Pure planning step - fetch remote, scan local, diff.
+    /// Discovery is network-bound and scanning is disk/CPU-bound, so the two
+    /// phases run concurrently and sync start latency is max() not sum().
     pub async fn plan(&self, req: &SyncRequest) -> Result<SyncPlan, SyncError> {
-        let fetch_res = self.fetch_remote_state(req).await?;
-        let local = self.scan_local_state(req, None).await?;
+        let (fetch_res, local) = tokio::try_join!(
+            self.fetch_remote_state(req),
+            self.scan_local_state(req, None)
+        )?;
         self.compute_plan(&fetch_res.manifest, &local, req)
     }
 
-    /// Plan + execute.
+    /// Plan + execute. Each phase runs inside a tracing span and is timed
+    /// into the [`SyncPerfReport`](crate::sync::perf::SyncPerfReport)
+    /// attached to the result.
     pub async fn plan_and_execute(
         &self,
         req: &SyncRequest,
         progress_tx: Option<Sender<DownloadEvent>>,
     ) -> Result<SyncResult, SyncError> {
-        let fetch_res = self.fetch_remote_state(req).await?;
+        use tracing::Instrument;
+
+        let total_started = Instant::now();
+
+        // Fetch and scan run concurrently; each is timed independently so the
+        // report shows which one the join actually waited on. The progress
+        // callback keeps the final ScanStats snapshot for cache-hit-rate
+        // reporting.
+        let scan_stats: Arc<std::sync::Mutex<fleet_scanner::ScanStats>> = Arc::default();
+        let stats_sink = scan_stats.clone();
+        let fetch = async {
+            let started = Instant::now();
+            let res = self.fetch_remote_state(req).await?;
+            Ok::<_, SyncError>((res, started.elapsed()))
+        }
+        .instrument(tracing::info_span!("sync_fetch"));
+        let scan = async {
+            let started = Instant::now();
+            let res = self
+                .scan_local_state(
+                    req,
+                    Some(Box::new(move |s| {
+                        *stats_sink.lock().unwrap() = s;
+                    })),
+                )
+                .await?;
+            Ok::<_, SyncError>((res, started.elapsed()))
+        }
+        .instrument(tracing::info_span!("sync_scan"));
+        let ((fetch_res, fetch_elapsed), (local, scan_elapsed)) = tokio::try_join!(fetch, scan)?;
+
+        let options = merge_mirrors(&req.options, &fetch_res.mirrors);
         let manifest = fetch_res.manifest;
-        let local = self.scan_local_state(req, None).await?;
-        let plan = self.compute_plan(&manifest, &local, req)?;
-        self.execute_with_plan_internal(req, plan, Some(manifest), progress_tx)
-            .await
+
+        let diff_started = Instant::now();
+        let plan = tracing::info_span!("sync_diff")
+            .in_scope(|| self.compute_plan(&manifest, &local, req))?;
+        let diff_elapsed = diff_started.elapsed();
+
+        let execute_started = Instant::now();
+        let mut result = self
+            .execute_with_plan_internal(req, &options, plan, Some(manifest), progress_tx)
+            .instrument(tracing::info_span!("sync_execute"))
+            .await?;
+        let execute_elapsed = execute_started.elapsed();
+
+        let scan_snapshot = scan_stats.lock().unwrap().clone();
+        let report = crate::sync::perf::SyncPerfReport {
+            total: crate::sync::perf::PhasePerf::new(
+                total_started.elapsed(),
+                scan_snapshot.bytes_processed + result.stats.bytes_planned_download,
+            ),
+            fetch: crate::sync::perf::PhasePerf::new(fetch_elapsed, 0),
+            scan: crate::sync::perf::PhasePerf::new(scan_elapsed, scan_snapshot.bytes_processed),
+            diff: crate::sync::perf::PhasePerf::new(diff_elapsed, 0),
+            execute: crate::sync::perf::PhasePerf::new(
+                execute_elapsed,
+                result.stats.bytes_planned_download,
+            ),
+            scan_files_total: scan_snapshot.files_scanned,
+            scan_files_cached: scan_snapshot.files_cached,
+            scan_cache_hit_rate: if scan_snapshot.files_scanned > 0 {
+                scan_snapshot.files_cached as f64 / scan_snapshot.files_scanned as f64
+            } else {
+                0.0
+            },
+            limiter_wait_ms: result.stats.limiter_wait_ms,
+            slowest_downloads: crate::sync::perf::SyncPerfReport::keep_slowest(
+                result.stats.download_timings.clone(),
+            ),
+        };
+        tracing::info!(
+            fetch_ms = report.fetch.duration_ms,
+            scan_ms = report.scan.duration_ms,
+            diff_ms = report.diff.duration_ms,
+            execute_ms = report.execute.duration_ms,
+            limiter_wait_ms = report.limiter_wait_ms,
+            "sync phase timings"
+        );
+        result.perf = Some(report);
+        Ok(result)
+    }
+
+    /// Plan + execute, pipelined per mod: as each mod's local scan completes
+    /// it is diffed against the remote manifest and its downloads start
+    /// immediately, so bandwidth is used seconds into a sync instead of after
+    /// the full tree has been hashed. Only the hashing modes benefit; the
+    /// stat-only modes delegate to [`plan_and_execute`](Self::plan_and_execute).
+    ///
+    /// Download progress ids restart for every mod, so consumers keying on
+    /// `DownloadEvent::id` should scope ids between Started and Completed
+    /// rather than treating them as globally unique.
+    pub async fn plan_and_execute_streaming(
+        &self,
+        req: &SyncRequest,
+        progress_tx: Option<Sender<DownloadEvent>>,
+    ) -> Result<SyncResult, SyncError> {
+        let strategy = match req.mode {
+            SyncMode::SmartVerify => fleet_scanner::ScanStrategy::SmartCache,
+            SyncMode::FullRehash => fleet_scanner::ScanStrategy::ForceRehash,
+            _ => return self.plan_and_execute(req, progress_tx).await,
+        };
+
+        let (mod_tx, mut mod_rx) = tokio::sync::mpsc::unbounded_channel::<fleet_core::Mod>();
+        let root = req.local_root.clone();
+        let cache_store: Arc<dyn fleet_scanner::ScanCacheStore> =
+            Arc::new(crate::sync::local::FleetDataScanCacheStore {
+                root: root.clone(),
+                fleet_data: self.fleet_data.clone(),
+            });
+        let scan = tokio::task::spawn_blocking(move || {
+            Scanner::scan_directory_streaming(
+                &root,
+                strategy,
+                None,
+                Some(cache_store),
+                None,
+                move |m| {
+                    let _ = mod_tx.send(m.clone());
+                },
+            )
+        });
+
+        let fetch_res = self.fetch_remote_state(req).await?;
+        let options = merge_mirrors(&req.options, &fetch_res.mirrors);
+        let remote_manifest = fetch_res.manifest;
+        // Keyed lowercase to preserve the case-insensitive mod matching the
+        // batch diff performs.
+        let mut remaining: HashMap<String, &fleet_core::Mod> = remote_manifest
+            .mods
+            .iter()
+            .map(|m| (m.name.to_lowercase(), m))
+            .collect();
+
+        let mut merged = SyncPlan {
+            renames: Vec::new(),
+            checks: Vec::new(),
+            downloads: Vec::new(),
+            deletes: Vec::new(),
+        };
+        let mut artifacts = Vec::new();
+        let mut stats = SyncStats::default();
+        let mut executed = false;
+        // Verified files are persisted to the scan cache while later mods are
+        // still scanning and downloading, leaving only a cheap sealing commit
+        // at the end.
+        let cache_writer = CacheWriteBehind::spawn(self.fleet_data.clone(), req.local_root.clone());
+
+        while let Some(local_mod) = mod_rx.recv().await {
+            // An unmatched local mod diffs against nothing and gets deleted.
+            let remote_mods = match remaining.remove(&local_mod.name.to_lowercase()) {
+                Some(m) => vec![m.clone()],
+                None => Vec::new(),
+            };
+            let sub_plan = diff_manifests(
+                &fleet_core::Manifest {
+                    version: "1.0".to_string(),
+                    mods: remote_mods,
+                },
+                &fleet_core::Manifest {
+                    version: "1.0".to_string(),
+                    mods: vec![local_mod],
+                },
+            );
+            self.run_sub_plan(
+                req,
+                &options,
+                sub_plan,
+                &progress_tx,
+                &cache_writer,
+                &mut merged,
+                &mut artifacts,
+                &mut stats,
+                &mut executed,
+            )
+            .await?;
+        }
+
+        // The channel closed, so the scan is done; surface any scan error
+        // before trusting the plan as complete.
+        scan.await
+            .map_err(|e| SyncError::Local(format!("scan join failed: {e}")))?
+            .map_err(|e| SyncError::Local(format!("scan failed: {e}")))?;
+
+        // Remote mods with no local directory yet are pure downloads.
+        let fresh: Vec<fleet_core::Mod> = remaining.into_values().cloned().collect();
+        if !fresh.is_empty() {
+            let sub_plan = diff_manifests(
+                &fleet_core::Manifest {
+                    version: "1.0".to_string(),
+                    mods: fresh,
+                },
+                &fleet_core::Manifest {
+                    version: "1.0".to_string(),
+                    mods: Vec::new(),
+                },
+            );
+            self.run_sub_plan(
+                req,
+                &options,
+                sub_plan,
+                &progress_tx,
+                &cache_writer,
+                &mut merged,
+                &mut artifacts,
+                &mut stats,
+                &mut executed,
+            )
+            .await?;
+        }
+
+        if !executed {
+            return Ok(SyncResult {
+                plan: merged,
+                executed: false,
+                stats,
+                perf: None,
+            });
+        }
+
+        cache_writer
+            .seal()
+            .map_err(|e| SyncError::Local(format!("scan cache flush failed: {e}")))?;
+        self.persist_sync_snapshot(req, &merged, &remote_manifest)?;
+
+        Ok(SyncResult {
+            plan: merged,
+            executed: true,
+            stats,
+            perf: None,
+        })
+    }
+
+    #[allow(clippy::too_many_arguments)]
+    async fn run_sub_plan(
+        &self,
+        req: &SyncRequest,
+        options: &SyncOptions,
+        sub_plan: SyncPlan,
+        progress_tx: &Option<Sender<DownloadEvent>>,
+        cache_writer: &CacheWriteBehind,
+        merged: &mut SyncPlan,
+        artifacts: &mut Vec<crate::sync::execute::SyncArtifact>,
+        stats: &mut SyncStats,
+        executed: &mut bool,
+    ) -> Result<(), SyncError> {
+        if sub_plan.deletes.is_empty()
+            && sub_plan.renames.is_empty()
+            && sub_plan.downloads.is_empty()
+        {
+            return Ok(());
+        }
+
+        let (arts, sub_stats) = self
+            .executor
+            .execute(
+                &req.local_root,
+                &req.repo_url,
+                sub_plan.clone(),
+                options,
+                progress_tx.clone(),
+            )
+            .await?;
+
+        for artifact in &arts {
+            cache_writer.record(upsert_record(artifact));
+        }
+        artifacts.extend(arts);
+        stats.files_planned_download += sub_stats.files_planned_download;
+        stats.bytes_planned_download += sub_stats.bytes_planned_download;
+        stats.files_deleted += sub_stats.files_deleted;
+        stats.mods_deleted += sub_stats.mods_deleted;
+        stats.renames += sub_stats.renames;
+        stats.limiter_wait_ms += sub_stats.limiter_wait_ms;
+        stats.download_timings.extend(sub_stats.download_timings);
+        merged.downloads.extend(sub_plan.downloads);
+        merged.deletes.extend(sub_plan.deletes);
+        merged.renames.extend(sub_plan.renames);
+        merged.checks.extend(sub_plan.checks);
+        *executed = true;
+        Ok(())
     }
 
     pub async fn execute_with_plan(
@@ -265,13 +612,14 @@ impl DefaultSyncEngine {
         plan: SyncPlan,
         progress_tx: Option<Sender<DownloadEvent>>,
     ) -> Result<SyncResult, SyncError> {
-        self.execute_with_plan_internal(req, plan, None, progress_tx)
+        self.execute_with_plan_internal(req, &req.options, plan, None, progress_tx)
             .await
     }
 
     async fn execute_with_plan_internal(
         &self,
         req: &SyncRequest,
+        options: &SyncOptions,
         plan: SyncPlan,
         remote_manifest: Option<fleet_core::Manifest>,
         progress_tx: Option<Sender<DownloadEvent>>,
@@ -281,6 +629,7 @@ impl DefaultSyncEngine {
                 plan,
                 executed: false,
                 stats: SyncStats::default(),
+                perf: None,
             });
         }
 
@@ -290,11 +639,18 @@ impl DefaultSyncEngine {
                 &req.local_root,
                 &req.repo_url,
                 plan.clone(),
-                &req.options,
+                options,
                 progress_tx,
             )
             .await?;
 
+        // Flush cache upserts in batches off-thread so the sealing commit
+        // below does not have to re-encode them in one large transaction.
+        let cache_writer = CacheWriteBehind::spawn(self.fleet_data.clone(), req.local_root.clone());
+        for artifact in &artifacts {
+            cache_writer.record(upsert_record(artifact));
+        }
+
         let manifest_to_save = if let Some(m) = remote_manifest {
             m
         } else {
@@ -305,18 +661,31 @@ impl DefaultSyncEngine {
                 .manifest
         };
 
-        let summary = compute_summary_from_manifest(&req.local_root, &manifest_to_save);
+        cache_writer
+            .seal()
+            .map_err(|e| SyncError::Local(format!("scan cache flush failed: {e}")))?;
+        self.persist_sync_snapshot(req, &plan, &manifest_to_save)?;
 
-        let cache_updates: Vec<CacheUpsertRecord> = artifacts
-            .iter()
-            .map(|a| CacheUpsertRecord {
-                mod_name: a.mod_name.clone(),
-                rel_path: a.rel_path.clone(),
-                mtime: a.final_mtime,
-                size: a.size,
-                checksum: a.checksum.clone(),
-            })
-            .collect();
+        Ok(SyncResult {
+            plan,
+            executed: true,
+            stats,
+            perf: None,
+        })
+    }
+
+    /// Seals the sync: commits the baseline manifest, summary, and remaining
+    /// cache maintenance (deletes/renames) in one transaction. Cache upserts
+    /// are not part of this commit - they are flushed incrementally by the
+    /// [`CacheWriteBehind`] writer while the sync is still running, which
+    /// keeps this final transaction cheap.
+    fn persist_sync_snapshot(
+        &self,
+        req: &SyncRequest,
+        plan: &SyncPlan,
+        manifest_to_save: &fleet_core::Manifest,
+    ) -> Result<(), SyncError> {
+        let summary = compute_summary_from_manifest(&req.local_root, manifest_to_save);
 
         let cache_deletes = plan
             .deletes
@@ -345,19 +714,13 @@ impl DefaultSyncEngine {
         self.fleet_data
             .commit_sync_snapshot(
                 &req.local_root,
-                &manifest_to_save,
+                manifest_to_save,
                 &summary,
-                &cache_updates,
+                &[],
                 &cache_deletes,
                 &cache_renames,
             )
-            .map_err(|e| SyncError::Local(format!("fleet.redb commit failed: {e}")))?;
-
-        Ok(SyncResult {
-            plan,
-            executed: true,
-            stats,
-        })
+            .map_err(|e| SyncError::Local(format!("fleet.redb commit failed: {e}")))
     }
 
     /// Persist the given manifest as the local baseline and write a matching summary file.
@@ -376,6 +739,30 @@ impl DefaultSyncEngine {
     }
 }
 
+/// User-configured mirrors plus whatever repo.json advertises, deduplicated.
+fn merge_mirrors(options: &SyncOptions, advertised: &[String]) -> SyncOptions {
+    let mut merged = options.clone();
+    for m in advertised {
+        if !merged.mirror_urls.contains(m) {
+            merged.mirror_urls.push(m.clone());
+        }
+    }
+    merged
+}
+
+fn upsert_record(a: &crate::sync::execute::SyncArtifact) -> CacheUpsertRecord {
+    CacheUpsertRecord {
+        mod_name: a.mod_name.clone(),
+        rel_path: a.rel_path.clone(),
+        mtime: a.final_mtime,
+        size: a.size,
+        checksum: a.checksum.clone(),
+        // Downloads verify via the streaming MD5 scanner; the fast track is
+        // seeded by the next local scan that hashes the file.
+        fast_checksum: String::new(),
+    }
+}
+
 fn split_mod_rel(path: &str) -> Option<(String, Option<String>)> {
     let cleaned = path.trim_end_matches('/');
     if let Some((mod_name, rel)) = cleaned.split_once('/') {
@@ -424,94 +811,68 @@ fn compute_summary_from_manifest(
     summaries
 }
 
-#[derive(Debug, Default)]
-struct SummaryDiff {
-    changed_files: Vec<String>,
-    missing_files: Vec<String>,
-    extra_files: Vec<String>,
-}
-
-fn diff_summary(repo: &LocalManifestSummary, local: &LocalManifestSummary) -> SummaryDiff {
-    let repo_map: HashMap<_, _> = repo
-        .files
-        .iter()
-        .map(|f| (f.rel_path.clone(), (f.mtime, f.size)))
-        .collect();
-    let local_map: HashMap<_, _> = local
-        .files
-        .iter()
-        .map(|f| (f.rel_path.clone(), (f.mtime, f.size)))
-        .collect();
-
-    let mut changed_files = Vec::new();
-    let mut missing_files = Vec::new();
-    let mut extra_files = Vec::new();
-
-    for (rel, (mtime, size)) in &repo_map {
-        match local_map.get(rel) {
-            Some((l_mtime, l_size)) => {
-                if l_mtime != mtime || l_size != size {
-                    changed_files.push(rel.clone());
-                }
-            }
-            None => missing_files.push(rel.clone()),
-        }
-    }
-
-    for rel in local_map.keys() {
-        if !repo_map.contains_key(rel) {
-            extra_files.push(rel.clone());
-        }
-    }
-
-    SummaryDiff {
-        changed_files,
-        missing_files,
-        extra_files,
+fn download_for(mod_name: &str, file: &LocalFileSummary) -> fleet_core::DownloadAction {
+    fleet_core::DownloadAction {
+        mod_name: mod_name.to_string(),
+        rel_path: file.rel_path.clone(),
+        size: file.size,
+        expected_checksum: file.checksum.clone(),
+        delta: None,
     }
 }
 
-fn build_fast_plan(
+/// Builds the FastCheck plan from persisted vs. freshly statted summaries.
+/// Public so the cargo bench target can drive it directly; not part of the
+/// engine's supported API surface.
+pub fn build_fast_plan(
     expected: &[LocalManifestSummary],
     current: &[LocalManifestSummary],
 ) -> SyncPlan {
     let mut downloads = Vec::new();
     let mut deletes = Vec::new();
 
-    let current_map: HashMap<_, _> = current.iter().map(|m| (m.mod_name.clone(), m)).collect();
+    // One borrowed-key index per side; the per-file loop below then resolves
+    // everything with hash lookups instead of nested linear scans, keeping
+    // planning linear even on a 500k-file, mostly-dirty tree.
+    let current_map: HashMap<&str, &LocalManifestSummary> = current
+        .iter()
+        .map(|m| (m.mod_name.as_str(), m))
+        .collect();
 
     for repo_mod in expected {
-        if let Some(local_mod) = current_map.get(&repo_mod.mod_name) {
-            let diff = diff_summary(repo_mod, local_mod);
-            for rel in diff.changed_files.iter().chain(diff.missing_files.iter()) {
-                if let Some(file) = repo_mod.files.iter().find(|f| &f.rel_path == rel) {
-                    downloads.push(fleet_core::DownloadAction {
-                        mod_name: repo_mod.mod_name.clone(),
-                        rel_path: file.rel_path.clone(),
-                        size: file.size,
-                        expected_checksum: file.checksum.clone(),
-                    });
+        if let Some(local_mod) = current_map.get(repo_mod.mod_name.as_str()) {
+            let local_index: HashMap<&str, &LocalFileSummary> = local_mod
+                .files
+                .iter()
+                .map(|f| (f.rel_path.as_str(), f))
+                .collect();
+
+            let mut expected_paths: HashSet<&str> = HashSet::with_capacity(repo_mod.files.len());
+            for file in &repo_mod.files {
+                expected_paths.insert(file.rel_path.as_str());
+                match local_index.get(file.rel_path.as_str()) {
+                    Some(local) if local.mtime == file.mtime && local.size == file.size => {}
+                    _ => downloads.push(download_for(&repo_mod.mod_name, file)),
                 }
             }
-            for rel in diff.extra_files {
-                deletes.push(fleet_core::DeleteAction {
-                    path: format!("{}/{}", repo_mod.mod_name, rel),
-                });
+
+            for local in &local_mod.files {
+                if !expected_paths.contains(local.rel_path.as_str()) {
+                    deletes.push(fleet_core::DeleteAction {
+                        path: format!("{}/{}", repo_mod.mod_name, local.rel_path),
+                    });
+                }
             }
         } else {
             for file in &repo_mod.files {
-                downloads.push(fleet_core::DownloadAction {
-                    mod_name: repo_mod.mod_name.clone(),
-                    rel_path: file.rel_path.clone(),
-                    size: file.size,
-                    expected_checksum: file.checksum.clone(),
-                });
+                downloads.push(download_for(&repo_mod.mod_name, file));
             }
         }
     }
 
+    let expected_mods: HashSet<&str> = expected.iter().map(|m| m.mod_name.as_str()).collect();
     for local_mod in current {
-        if !expected.iter().any(|m| m.mod_name == local_mod.mod_name) {
+        if !expected_mods.contains(local_mod.mod_name.as_str()) {
             deletes.push(fleet_core::DeleteAction {
                 path: local_mod.mod_name.clone(),
             });
@@ -28,6 +28,154 @@ fn validate_relative_path(path: &str) -> Result<(), SyncError> {
     Ok(())
 }
 
+/// Bound for concurrent filesystem operations (deletes/renames). High enough
+/// to hide per-file latency on NTFS, low enough not to starve downloads of
+/// disk bandwidth.
+const FS_OP_CONCURRENCY: usize = 8;
+
+/// Removes the given paths concurrently on the blocking pool and returns
+/// `(mods_deleted, files_deleted)`, counting directories as mods like the
+/// sequential loop this replaces.
+async fn delete_paths(paths: Vec<camino::Utf8PathBuf>) -> (u64, u64) {
+    use futures::stream::StreamExt;
+
+    let outcomes: Vec<(u64, u64)> = futures::stream::iter(paths)
+        .map(|path| {
+            tokio::task::spawn_blocking(move || {
+                if !path.exists() {
+                    (0, 0)
+                } else if path.is_dir() {
+                    let _ = std::fs::remove_dir_all(path.as_std_path());
+                    (1, 0)
+                } else {
+                    let _ = std::fs::remove_file(path.as_std_path());
+                    (0, 1)
+                }
+            })
+        })
+        .buffer_unordered(FS_OP_CONCURRENCY)
+        .map(|joined| joined.unwrap_or((0, 0)))
+        .collect()
+        .await;
+
+    outcomes
+        .into_iter()
+        .fold((0, 0), |(m, f), (dm, df)| (m + dm, f + df))
+}
+
+/// Lowercased top-level path segment, used to detect case-insensitive
+/// collisions between a delete tree and a download/rename target.
+fn top_segment_lower(path: &str) -> String {
+    path.trim_start_matches('/')
+        .split('/')
+        .next()
+        .unwrap_or("")
+        .to_lowercase()
+}
+
+/// Builds a checksum -> verified source path index over other profiles'
+/// persisted baseline summaries, restricted to the checksums this plan
+/// actually needs. A candidate only enters the index if its on-disk stat
+/// still matches the summary (the same mtime+size trust rule the scan cache
+/// uses), so a file modified since its last sync is never linked from.
+fn build_dedup_index(
+    current_root: &Utf8Path,
+    dedup_roots: &[camino::Utf8PathBuf],
+    needed: &std::collections::HashSet<&str>,
+) -> HashMap<String, camino::Utf8PathBuf> {
+    use fleet_persistence::{FleetDataStore, RedbFleetDataStore};
+
+    let store = RedbFleetDataStore;
+    let mut index: HashMap<String, camino::Utf8PathBuf> = HashMap::new();
+    for other_root in dedup_roots {
+        if other_root == current_root {
+            continue;
+        }
+        let summary = match store.load_baseline_summary(other_root) {
+            Ok(s) => s,
+            Err(e) => {
+                tracing::debug!("Dedup: no usable baseline in {other_root}: {e}");
+                continue;
+            }
+        };
+        for m in &summary {
+            for f in &m.files {
+                if !needed.contains(f.checksum.as_str()) || index.contains_key(&f.checksum) {
+                    continue;
+                }
+                let candidate = other_root.join(&m.mod_name).join(&f.rel_path);
+                let Ok(meta) = fs::metadata(candidate.as_std_path()) else {
+                    continue;
+                };
+                if meta.len() == f.size && Scanner::mtime(&meta) == f.mtime {
+                    index.insert(f.checksum.clone(), candidate);
+                }
+            }
+        }
+    }
+    index
+}
+
+/// Materializes `target` from an already-verified `source`: hardlink when
+/// both sit on the same filesystem, full copy otherwise. Either way the
+/// download is avoided. Hardlinks are safe against later divergence because
+/// syncs replace files via `.part` + rename, which breaks the link instead
+/// of writing through it.
+fn link_or_copy(source: &Utf8Path, target: &Utf8Path) -> std::io::Result<()> {
+    if let Some(parent) = target.parent() {
+        fs::create_dir_all(parent.as_std_path())?;
+    }
+    if target.as_std_path().exists() {
+        fs::remove_file(target.as_std_path())?;
+    }
+    if fs::hard_link(source.as_std_path(), target.as_std_path()).is_ok() {
+        return Ok(());
+    }
+    fs::copy(source.as_std_path(), target.as_std_path()).map(|_| ())
+}
+
+#[derive(Debug)]
+struct DlCtx {
+    mod_name: String,
+    rel_path: String,
+    checksum: String,
+    size: u64,
+}
+
+/// Orders download requests so the concurrency slots stay productive: mods
+/// are ranked by their largest transfer, and files within a mod are queued
+/// largest-first. Multi-GB PBOs enter the pipe immediately (with their mod's
+/// small files filling the remaining slots behind them) instead of occupying
+/// every slot at the end, the global tail is made of small files, and mods
+/// complete progressively rather than all at once.
+fn schedule_downloads(
+    mut requests: Vec<DownloadRequest>,
+    ctx_map: &HashMap<u64, DlCtx>,
+) -> Vec<DownloadRequest> {
+    let mut mod_rank: HashMap<&str, u64> = HashMap::new();
+    for req in &requests {
+        if let Some(ctx) = ctx_map.get(&req.id) {
+            let rank = mod_rank.entry(ctx.mod_name.as_str()).or_insert(0);
+            *rank = (*rank).max(req.expected_size);
+        }
+    }
+
+    requests.sort_by(|a, b| {
+        let (mod_a, mod_b) = match (ctx_map.get(&a.id), ctx_map.get(&b.id)) {
+            (Some(a), Some(b)) => (a.mod_name.as_str(), b.mod_name.as_str()),
+            _ => return a.id.cmp(&b.id),
+        };
+        let rank_a = mod_rank.get(mod_a).copied().unwrap_or(0);
+        let rank_b = mod_rank.get(mod_b).copied().unwrap_or(0);
+        rank_b
+            .cmp(&rank_a)
+            .then_with(|| mod_a.cmp(mod_b))
+            .then_with(|| b.expected_size.cmp(&a.expected_size))
+            .then_with(|| a.id.cmp(&b.id))
+    });
+    requests
+}
+
 #[derive(Debug, Clone)]
 pub struct SyncArtifact {
     pub mod_name: String,
@@ -72,7 +220,22 @@ impl PlanExecutor for DefaultPlanExecutor {
         let mut stats = SyncStats::default();
         let root_std = root.as_std_path();
 
-        // Deletes
+        // Deletes: validate everything up front, then split them. A delete
+        // whose top-level directory could collide with a download or rename
+        // target (case-insensitive filesystems make "@Mod" and "@mod" the
+        // same tree) must finish before downloads start; the rest - e.g. a
+        // retired 40 GB mod - run concurrently behind the download phase.
+        let occupied: std::collections::HashSet<String> = plan
+            .downloads
+            .iter()
+            .map(|d| d.mod_name.to_lowercase())
+            .chain(plan.renames.iter().flat_map(|r| {
+                [top_segment_lower(&r.old_path), top_segment_lower(&r.new_path)]
+            }))
+            .collect();
+
+        let mut blocking_deletes = Vec::new();
+        let mut overlapped_deletes = Vec::new();
         for del in &plan.deletes {
             validate_relative_path(&del.path)?;
             let path = root.join(&del.path);
@@ -81,47 +244,78 @@ impl PlanExecutor for DefaultPlanExecutor {
                     "Security: Delete path escapes root: {path}"
                 )));
             }
-            if path.exists() {
-                if path.is_dir() {
-                    let _ = tokio::fs::remove_dir_all(path.as_std_path()).await;
-                    stats.mods_deleted += 1;
-                } else {
-                    let _ = tokio::fs::remove_file(path.as_std_path()).await;
-                    stats.files_deleted += 1;
-                }
+            if occupied.contains(&top_segment_lower(&del.path)) {
+                blocking_deletes.push(path);
+            } else {
+                overlapped_deletes.push(path);
             }
         }
 
-        // Renames
-        for ren in &plan.renames {
-            validate_relative_path(&ren.old_path)?;
-            validate_relative_path(&ren.new_path)?;
+        let (mods_deleted, files_deleted) = delete_paths(blocking_deletes).await;
+        stats.mods_deleted += mods_deleted;
+        stats.files_deleted += files_deleted;
+        let overlapped = tokio::spawn(delete_paths(overlapped_deletes));
 
-            let old = root.join(&ren.old_path);
-            let new = root.join(&ren.new_path);
-            if !old.as_std_path().starts_with(root_std) || !new.as_std_path().starts_with(root_std)
-            {
-                return Err(SyncError::Execution(format!(
-                    "Security: Rename path escapes root: {} -> {}",
-                    ren.old_path, ren.new_path
-                )));
-            }
-            if old.exists() {
-                let _ = robust_rename(old.as_std_path(), new.as_std_path()).await;
-                stats.renames += 1;
+        // Renames: concurrent, but complete before downloads because the
+        // plan's download paths refer to the post-rename layout.
+        {
+            use futures::stream::StreamExt;
+
+            let mut pairs = Vec::new();
+            for ren in &plan.renames {
+                validate_relative_path(&ren.old_path)?;
+                validate_relative_path(&ren.new_path)?;
+
+                let old = root.join(&ren.old_path);
+                let new = root.join(&ren.new_path);
+                if !old.as_std_path().starts_with(root_std)
+                    || !new.as_std_path().starts_with(root_std)
+                {
+                    return Err(SyncError::Execution(format!(
+                        "Security: Rename path escapes root: {} -> {}",
+                        ren.old_path, ren.new_path
+                    )));
+                }
+                if old.exists() {
+                    pairs.push((old, new));
+                    stats.renames += 1;
+                }
             }
+
+            futures::stream::iter(pairs)
+                .for_each_concurrent(FS_OP_CONCURRENCY, |(old, new)| async move {
+                    let _ = robust_rename(old.as_std_path(), new.as_std_path()).await;
+                })
+                .await;
         }
 
+        // Cross-profile dedup: checksums this plan needs that another
+        // profile already holds verified on disk are linked, not downloaded.
+        let dedup_index = if opts.dedup_roots.is_empty() {
+            HashMap::new()
+        } else {
+            let needed: std::collections::HashSet<&str> = plan
+                .downloads
+                .iter()
+                .map(|d| d.expected_checksum.as_str())
+                .collect();
+            let current_root = root.to_owned();
+            let dedup_roots = opts.dedup_roots.clone();
+            let needed_owned: std::collections::HashSet<String> =
+                needed.iter().map(|s| s.to_string()).collect();
+            tokio::task::spawn_blocking(move || {
+                let needed: std::collections::HashSet<&str> =
+                    needed_owned.iter().map(|s| s.as_str()).collect();
+                build_dedup_index(&current_root, &dedup_roots, &needed)
+            })
+            .await
+            .map_err(|e| SyncError::Execution(format!("dedup index join failed: {e}")))?
+        };
+
         // Downloads
         let mut requests = Vec::new();
-        #[derive(Debug)]
-        struct DlCtx {
-            mod_name: String,
-            rel_path: String,
-            checksum: String,
-            size: u64,
-        }
         let mut ctx_map = HashMap::new();
+        let mut linked: Vec<(String, String, String)> = Vec::new();
 
         for (i, action) in plan.downloads.iter().enumerate() {
             // SECURITY CHECK
@@ -131,6 +325,15 @@ impl PlanExecutor for DefaultPlanExecutor {
             let id = i as u64;
             let url = build_file_url(repo_url, &action.mod_name, &action.rel_path)
                 .map_err(SyncError::Execution)?;
+            // The same file on every configured mirror; an unparsable mirror
+            // URL degrades to not using that mirror rather than failing the
+            // whole sync.
+            let mirror_urls: Vec<String> = opts
+                .mirror_urls
+                .iter()
+                .filter_map(|m| build_file_url(m, &action.mod_name, &action.rel_path).ok())
+                .filter(|m| *m != url)
+                .collect();
             // Normalize relative path so on-disk layout is consistent
             let normalized_rel = FleetPath::normalize(&action.rel_path);
             // Re-validate after normalization just to be safe
@@ -143,12 +346,40 @@ impl PlanExecutor for DefaultPlanExecutor {
                     target
                 )));
             }
+            if let Some(source) = dedup_index.get(&action.expected_checksum) {
+                match link_or_copy(source, &target) {
+                    Ok(()) => {
+                        tracing::debug!("Dedup: {} <- {}", target, source);
+                        stats.files_linked += 1;
+                        stats.bytes_linked += action.size;
+                        linked.push((
+                            action.mod_name.clone(),
+                            normalized_rel,
+                            action.expected_checksum.clone(),
+                        ));
+                        continue;
+                    }
+                    Err(e) => {
+                        tracing::warn!("Dedup link {} <- {} failed, downloading: {e}", target, source);
+                    }
+                }
+            }
+
+            // Delta splicing needs the old file on disk to copy from.
+            let delta = if target.as_std_path().is_file() {
+                action.delta.clone()
+            } else {
+                None
+            };
+
             requests.push(DownloadRequest {
                 id,
                 url,
+                mirror_urls,
                 target_path: target,
                 expected_size: action.size,
                 expected_checksum: Some(action.expected_checksum.clone()),
+                delta,
             });
             ctx_map.insert(
                 id,
@@ -164,13 +395,92 @@ impl PlanExecutor for DefaultPlanExecutor {
             stats.bytes_planned_download += action.size;
         }
 
-        let downloader =
+        let requests = schedule_downloads(requests, &ctx_map);
+
+        // Wrap the caller's progress channel so per-mod completion events can
+        // be injected: the downloader only knows request ids, but the ctx map
+        // knows which mod each id belongs to.
+        let (batch_tx, forwarder) = match progress_tx {
+            Some(outer) => {
+                let mut mod_of: HashMap<u64, String> = HashMap::new();
+                let mut pending: HashMap<String, u64> = HashMap::new();
+                for ctx in ctx_map.values() {
+                    *pending.entry(ctx.mod_name.clone()).or_insert(0) += 1;
+                }
+                for (&id, ctx) in &ctx_map {
+                    mod_of.insert(id, ctx.mod_name.clone());
+                }
+                let (tx, mut rx) = tokio::sync::mpsc::channel::<DownloadEvent>(1024);
+                let forwarder = tokio::spawn(async move {
+                    while let Some(ev) = rx.recv().await {
+                        let completed_mod = match &ev {
+                            DownloadEvent::Completed { id, success: true } => {
+                                mod_of.get(id).and_then(|m| {
+                                    let left = pending.get_mut(m)?;
+                                    *left = left.saturating_sub(1);
+                                    (*left == 0).then(|| m.clone())
+                                })
+                            }
+                            _ => None,
+                        };
+                        let _ = outer.send(ev).await;
+                        if let Some(mod_name) = completed_mod {
+                            let _ = outer.send(DownloadEvent::ModCompleted { mod_name }).await;
+                        }
+                    }
+                });
+                (Some(tx), Some(forwarder))
+            }
+            None => (None, None),
+        };
+
+        let mut downloader =
             Downloader::new(self.client.clone(), opts.max_threads, opts.rate_limit_bytes);
-        let results = downloader.download_batch(requests, progress_tx).await;
+        if let Some(table) = &opts.progress_table {
+            downloader = downloader.with_progress_table(table.clone());
+        }
+        let (results, limiter_wait) = downloader.download_batch_timed(requests, batch_tx).await;
+        stats.limiter_wait_ms = limiter_wait.as_millis() as u64;
+        if let Some(forwarder) = forwarder {
+            let _ = forwarder.await;
+        }
+
+        // Settle the deletes that ran behind the downloads.
+        let (mods_deleted, files_deleted) = overlapped
+            .await
+            .map_err(|e| SyncError::Execution(format!("background delete join failed: {e}")))?;
+        stats.mods_deleted += mods_deleted;
+        stats.files_deleted += files_deleted;
 
         let mut artifacts = Vec::new();
         let mut failed = 0;
+
+        // Linked files are artifacts too: the snapshot commit records them
+        // with the mtime/size the link actually landed with on disk.
+        for (mod_name, rel_path, checksum) in linked {
+            let abs_path = root.join(&mod_name).join(&rel_path);
+            match fs::metadata(abs_path.as_std_path()) {
+                Ok(meta) => artifacts.push(SyncArtifact {
+                    mod_name,
+                    rel_path,
+                    checksum,
+                    size: meta.len(),
+                    final_mtime: Scanner::mtime(&meta),
+                }),
+                Err(e) => {
+                    tracing::error!("Failed to stat linked file {}: {}", abs_path, e);
+                    failed += 1;
+                }
+            }
+        }
         for res in results {
+            if let Some(ctx) = ctx_map.get(&res.id) {
+                stats.download_timings.push(crate::sync::perf::DownloadTiming {
+                    path: format!("{}/{}", ctx.mod_name, ctx.rel_path),
+                    bytes: res.bytes_downloaded,
+                    duration_ms: res.elapsed.as_millis() as u64,
+                });
+            }
             if res.success {
                 if let Some(ctx) = ctx_map.get(&res.id) {
                     let abs_path = root.join(&ctx.mod_name).join(&ctx.rel_path);
@@ -242,7 +552,57 @@ fn build_file_url(repo_url: &str, mod_name: &str, rel_path: &str) -> Result<Stri
 
 #[cfg(test)]
 mod tests {
-    use super::build_file_url;
+    use super::{build_file_url, schedule_downloads, DlCtx};
+    use fleet_infra::net::DownloadRequest;
+    use std::collections::HashMap;
+
+    fn request(id: u64, size: u64) -> DownloadRequest {
+        DownloadRequest {
+            id,
+            url: format!("http://example.com/{id}"),
+            mirror_urls: Vec::new(),
+            target_path: camino::Utf8PathBuf::from(format!("/tmp/{id}")),
+            expected_size: size,
+            expected_checksum: None,
+            delta: None,
+        }
+    }
+
+    fn ctx(mod_name: &str, size: u64) -> DlCtx {
+        DlCtx {
+            mod_name: mod_name.to_string(),
+            rel_path: String::new(),
+            checksum: String::new(),
+            size,
+        }
+    }
+
+    #[test]
+    fn schedule_orders_mods_by_largest_transfer_and_files_largest_first() {
+        // @small: two tiny files. @big: one huge PBO plus a tiny config.
+        let requests = vec![
+            request(0, 10),
+            request(1, 20),
+            request(2, 5_000_000_000),
+            request(3, 15),
+        ];
+        let ctx_map: HashMap<u64, DlCtx> = [
+            (0, ctx("@small", 10)),
+            (1, ctx("@small", 20)),
+            (2, ctx("@big", 5_000_000_000)),
+            (3, ctx("@big", 15)),
+        ]
+        .into();
+
+        let ordered: Vec<u64> = schedule_downloads(requests, &ctx_map)
+            .into_iter()
+            .map(|r| r.id)
+            .collect();
+
+        // The huge PBO starts immediately; its mod's small file fills the
+        // next slot; the small mod's files (largest first) form the tail.
+        assert_eq!(ordered, vec![2, 3, 1, 0]);
+    }
 
     #[test]
     fn build_file_url_accepts_repo_json_url() {
@@ -10,6 +10,8 @@ use crate::sync::storage::{LocalFileSummary, LocalManifestSummary};
 use crate::sync::{SyncError, SyncMode};
 use fleet_infra::hashing::compute_file_checksum;
 use fleet_persistence::{CacheUpsert, FleetDataStore};
+use fleet_scanner::watch::RootWatcher;
+use std::collections::{HashMap, HashSet};
 use std::sync::Arc;
 
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
@@ -133,6 +135,7 @@ impl DefaultLocalStateProvider {
                         checksum: checksum.clone(),
                         file_type: FileType::File,
                         parts: Vec::new(),
+                        canonical: Default::default(),
                     });
 
                     summary_files.push(LocalFileSummary {
@@ -422,9 +425,9 @@ impl DefaultLocalStateProvider {
     }
 }
 
-struct FleetDataScanCacheStore {
-    root: Utf8PathBuf,
-    fleet_data: Arc<dyn FleetDataStore>,
+pub(crate) struct FleetDataScanCacheStore {
+    pub(crate) root: Utf8PathBuf,
+    pub(crate) fleet_data: Arc<dyn FleetDataStore>,
 }
 
 impl ScanCacheStore for FleetDataScanCacheStore {
@@ -444,6 +447,7 @@ impl ScanCacheStore for FleetDataScanCacheStore {
                     mtime: e.mtime,
                     size: e.size,
                     checksum: e.checksum,
+                    fast_checksum: e.fast_checksum,
                 },
             );
         }
@@ -462,6 +466,7 @@ impl ScanCacheStore for FleetDataScanCacheStore {
                 mtime: e.mtime,
                 size: e.size,
                 checksum: e.checksum.clone(),
+                fast_checksum: e.fast_checksum.clone(),
             });
         }
         if let Err(e) = self
@@ -478,34 +483,39 @@ fn build_summary_from_manifest(
     root: &Utf8Path,
     manifest: &Manifest,
 ) -> Result<Vec<LocalManifestSummary>, String> {
-    let mut summaries = Vec::new();
-    for m in &manifest.mods {
-        let mod_root = root.join(&m.name);
-        if !mod_root.exists() || !mod_root.is_dir() {
-            continue;
-        }
+    Ok(manifest
+        .mods
+        .iter()
+        .filter_map(|m| build_mod_summary(root, m))
+        .collect())
+}
 
-        let mut files = Vec::new();
-        for f in &m.files {
-            let fs_path = mod_root.join(&f.path);
-            if let Ok(meta) = std::fs::metadata(&fs_path) {
-                let mtime = Scanner::mtime(&meta);
-                files.push(LocalFileSummary {
-                    rel_path: FleetPath::normalize(&f.path),
-                    mtime,
-                    size: meta.len(),
-                    checksum: f.checksum.clone(),
-                });
-            }
-        }
+/// Stats one mod's manifest files into a summary; `None` when the mod
+/// directory itself is gone.
+fn build_mod_summary(root: &Utf8Path, m: &Mod) -> Option<LocalManifestSummary> {
+    let mod_root = root.join(&m.name);
+    if !mod_root.is_dir() {
+        return None;
+    }
 
-        summaries.push(LocalManifestSummary {
-            mod_name: m.name.clone(),
-            files,
-        });
+    let mut files = Vec::new();
+    for f in &m.files {
+        let fs_path = mod_root.join(&f.path);
+        if let Ok(meta) = std::fs::metadata(&fs_path) {
+            let mtime = Scanner::mtime(&meta);
+            files.push(LocalFileSummary {
+                rel_path: FleetPath::normalize(&f.path),
+                mtime,
+                size: meta.len(),
+                checksum: f.checksum.clone(),
+            });
+        }
     }
 
-    Ok(summaries)
+    Some(LocalManifestSummary {
+        mod_name: m.name.clone(),
+        files,
+    })
 }
 
 #[async_trait::async_trait]
@@ -526,6 +536,152 @@ impl LocalStateProvider for DefaultLocalStateProvider {
     }
 }
 
+/// Watcher-backed provider for long-running processes (the egui app, the
+/// CLI's watch mode). The first check of a root installs a recursive
+/// filesystem watcher and pays for one full scan; every later check re-scans
+/// only the mods the watcher flagged since the previous answer and splices
+/// them into the retained state, so a quiet tree answers without touching
+/// the filesystem at all and a busy one in O(changed mods). The incremental
+/// re-scans run through `Scanner`, which also keeps the scan cache current
+/// as files change.
+///
+/// One-shot processes should stay on [`DefaultLocalStateProvider`]: the
+/// watcher only pays off from the second check onwards.
+pub struct WatchedLocalStateProvider {
+    inner: DefaultLocalStateProvider,
+    roots: tokio::sync::Mutex<HashMap<Utf8PathBuf, WatchedRoot>>,
+}
+
+struct WatchedRoot {
+    watcher: RootWatcher,
+    state: Option<LocalState>,
+}
+
+impl WatchedLocalStateProvider {
+    pub fn new(fleet_data: Arc<dyn FleetDataStore>) -> Self {
+        Self {
+            inner: DefaultLocalStateProvider::new(fleet_data),
+            roots: tokio::sync::Mutex::new(HashMap::new()),
+        }
+    }
+}
+
+#[async_trait::async_trait]
+impl LocalStateProvider for WatchedLocalStateProvider {
+    async fn local_state(
+        &self,
+        root: &Utf8Path,
+        mode: SyncMode,
+        on_progress: Option<Box<dyn Fn(fleet_scanner::ScanStats) + Send + Sync>>,
+    ) -> Result<LocalState, SyncError> {
+        // No filesystem walk to save.
+        if matches!(mode, SyncMode::CacheOnly) {
+            return self.inner.local_state(root, mode, on_progress).await;
+        }
+
+        let mut roots = self.roots.lock().await;
+        let entry = match roots.entry(root.to_owned()) {
+            std::collections::hash_map::Entry::Occupied(e) => e.into_mut(),
+            std::collections::hash_map::Entry::Vacant(v) => match RootWatcher::new(root) {
+                Ok(watcher) => v.insert(WatchedRoot {
+                    watcher,
+                    state: None,
+                }),
+                Err(e) => {
+                    tracing::warn!("Watcher unavailable for {root}: {e}; using full scans");
+                    drop(roots);
+                    return self.inner.local_state(root, mode, on_progress).await;
+                }
+            },
+        };
+
+        // Drained before scanning: anything that changes mid-scan queues up
+        // for the next check instead of being lost.
+        let delta = entry.watcher.drain();
+
+        // All watched answers are Scanner-grade, so any mode can be served
+        // from the same retained state; a full rehash always starts over.
+        let (strategy, trust) = if matches!(mode, SyncMode::FullRehash) {
+            (ScanStrategy::ForceRehash, LocalTrustLevel::VerifiedFull)
+        } else {
+            (ScanStrategy::SmartCache, LocalTrustLevel::VerifiedSmart)
+        };
+
+        if entry.state.is_none()
+            || delta.lost_track
+            || matches!(mode, SyncMode::FullRehash)
+        {
+            let state = self
+                .inner
+                .scan_with_strategy(root, strategy, trust, on_progress)
+                .await?;
+            entry.state = Some(state.clone());
+            return Ok(state);
+        }
+
+        let prev = entry.state.clone().unwrap();
+        if delta.dirty_mods.is_empty() {
+            return Ok(prev);
+        }
+
+        let dirty: Vec<String> = delta.dirty_mods.into_iter().collect();
+        let cache_store: Arc<dyn ScanCacheStore> = Arc::new(FleetDataScanCacheStore {
+            root: root.to_owned(),
+            fleet_data: self.inner.fleet_data.clone(),
+        });
+        let root_owned = root.to_owned();
+        let names = dirty.clone();
+        let scanned = tokio::task::spawn_blocking(move || {
+            Scanner::scan_mods(
+                &root_owned,
+                &names,
+                ScanStrategy::SmartCache,
+                on_progress,
+                Some(cache_store),
+                None,
+            )
+        })
+        .await
+        .map_err(|e| SyncError::Local(format!("incremental scan join failed: {e}")))?
+        .map_err(|e| SyncError::Local(format!("incremental scan failed: {e}")))?;
+
+        // Splice the fresh mods over the retained state. Dirty mods whose
+        // directory vanished are absent from `scanned` and simply drop out.
+        let dirty_set: HashSet<&str> = dirty.iter().map(String::as_str).collect();
+        let mut mods: Vec<Mod> = prev
+            .manifest
+            .mods
+            .into_iter()
+            .filter(|m| !dirty_set.contains(m.name.as_str()))
+            .collect();
+        let mut summary: Vec<LocalManifestSummary> = prev
+            .summary
+            .unwrap_or_default()
+            .into_iter()
+            .filter(|s| !dirty_set.contains(s.mod_name.as_str()))
+            .collect();
+        for m in scanned {
+            if let Some(s) = build_mod_summary(root, &m) {
+                summary.push(s);
+            }
+            mods.push(m);
+        }
+        mods.sort_by(|a, b| a.name.cmp(&b.name));
+        summary.sort_by(|a, b| a.mod_name.cmp(&b.mod_name));
+
+        let state = LocalState {
+            manifest: Manifest {
+                version: prev.manifest.version,
+                mods,
+            },
+            summary: Some(summary),
+            trust: LocalTrustLevel::VerifiedSmart,
+        };
+        entry.state = Some(state.clone());
+        Ok(state)
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -559,6 +715,7 @@ mod tests {
                     mtime,
                     size: len,
                     checksum: checksum.clone(),
+                    fast_checksum: String::new(),
                 }],
             )
             .unwrap();
@@ -598,6 +755,7 @@ mod tests {
                     mtime,
                     size: len,
                     checksum: "abc".into(),
+                    fast_checksum: String::new(),
                 }],
             )
             .unwrap();
@@ -614,4 +772,50 @@ mod tests {
             .unwrap();
         assert_eq!(f.checksum, ""); // treated as dirty
     }
+
+    #[tokio::test]
+    async fn watched_provider_picks_up_changes_incrementally() {
+        let dir = tempdir().unwrap();
+        let root = Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+        let mod_dir = root.join("@m");
+        std::fs::create_dir_all(&mod_dir).unwrap();
+        let file_path = mod_dir.join("file.txt");
+        std::fs::write(&file_path, b"hello").unwrap();
+
+        let provider = WatchedLocalStateProvider::new(Arc::new(RedbFleetDataStore));
+
+        let first = provider
+            .local_state(&root, SyncMode::SmartVerify, None)
+            .await
+            .unwrap();
+        assert_eq!(first.trust, LocalTrustLevel::VerifiedSmart);
+        assert!(first.summary.is_some());
+        let stale = first.manifest.mods[0].files[0].checksum.clone();
+
+        std::fs::write(&file_path, b"hello, but longer and different").unwrap();
+        let expected = compute_file_checksum(&file_path, Utf8Path::new("file.txt")).unwrap();
+
+        // Change notifications arrive asynchronously; poll until the watched
+        // state reflects the rewrite. FastCheck is deliberately used here:
+        // any watched mode is answered from the same retained state.
+        let deadline = std::time::Instant::now() + std::time::Duration::from_secs(10);
+        loop {
+            let state = provider
+                .local_state(&root, SyncMode::FastCheck, None)
+                .await
+                .unwrap();
+            let current = state.manifest.mods[0].files[0].checksum.clone();
+            if current != stale {
+                assert_eq!(current, expected);
+                let summary = state.summary.unwrap();
+                assert_eq!(summary[0].files[0].checksum, expected);
+                break;
+            }
+            assert!(
+                std::time::Instant::now() < deadline,
+                "watched state never saw the rewrite"
+            );
+            tokio::time::sleep(std::time::Duration::from_millis(50)).await;
+        }
+    }
 }
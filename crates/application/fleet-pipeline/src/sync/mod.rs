@@ -5,6 +5,7 @@ use serde::{Deserialize, Serialize};
 pub mod engine;
 pub mod execute;
 pub mod local;
+pub mod perf;
 pub mod remote;
 pub mod storage;
 
@@ -19,6 +20,8 @@ pub struct FetchStats {
 pub struct FetchResult {
     pub manifest: fleet_core::Manifest,
     pub stats: FetchStats,
+    /// Mirror base URLs advertised by repo.json.
+    pub mirrors: Vec<String>,
 }
 
 #[derive(Debug, Clone, Copy)]
@@ -40,6 +43,18 @@ pub struct SyncOptions {
     pub max_threads: usize,
     pub rate_limit_bytes: Option<u64>,
     pub cache_root: Option<Utf8PathBuf>,
+    /// Alternate repo base URLs to spread downloads across. The engine merges
+    /// mirrors advertised by repo.json into this list before executing.
+    pub mirror_urls: Vec<String>,
+    /// When set, downloads report byte progress into this table (sampled by
+    /// the consumer at its own cadence) instead of sending
+    /// `DownloadEvent::Progress` per chunk batch; the event channel then only
+    /// carries Started/Completed transitions.
+    pub progress_table: Option<std::sync::Arc<fleet_infra::net::ProgressTable>>,
+    /// Local roots of other profiles to consult before downloading: a file
+    /// whose checksum already exists verified in one of these roots is
+    /// hardlinked (or copied, across filesystems) instead of downloaded.
+    pub dedup_roots: Vec<Utf8PathBuf>,
 }
 
 impl Default for SyncOptions {
@@ -48,6 +63,9 @@ impl Default for SyncOptions {
             max_threads: 4,
             rate_limit_bytes: None,
             cache_root: None,
+            mirror_urls: Vec::new(),
+            progress_table: None,
+            dedup_roots: Vec::new(),
         }
     }
 }
@@ -68,6 +86,14 @@ pub struct SyncStats {
     pub files_deleted: u64,
     pub mods_deleted: u64,
     pub renames: u64,
+    /// Files satisfied by hardlink/copy from another profile instead of a
+    /// download, and the transfer bytes that saved.
+    pub files_linked: u64,
+    pub bytes_linked: u64,
+    /// Time downloads spent parked in the rate limiter.
+    pub limiter_wait_ms: u64,
+    /// Per-download wall timings, kept for slowest-file reporting.
+    pub download_timings: Vec<perf::DownloadTiming>,
 }
 
 #[derive(Debug, Clone)]
@@ -75,6 +101,10 @@ pub struct SyncResult {
     pub plan: SyncPlan,
     pub executed: bool,
     pub stats: SyncStats,
+    /// Phase-level timing breakdown; populated by
+    /// [`plan_and_execute`](DefaultSyncEngine::plan_and_execute), `None` for
+    /// entry points that skip one of the phases.
+    pub perf: Option<perf::SyncPerfReport>,
 }
 
 /// High-level error type for sync operations.
@@ -90,10 +120,17 @@ pub enum SyncError {
     Execution(String),
 }
 
-pub use engine::DefaultSyncEngine;
-pub use local::{LocalState, LocalStateProvider, LocalTrustLevel};
+pub use engine::{DefaultSyncEngine, RemoteFreshness};
+pub use local::{LocalState, LocalStateProvider, LocalTrustLevel, WatchedLocalStateProvider};
 
 /// Convenience constructor for the default engine.
 pub fn default_engine(client: reqwest::Client) -> DefaultSyncEngine {
     DefaultSyncEngine::new(client)
 }
+
+/// Engine for long-running processes: local state is served by a
+/// [`WatchedLocalStateProvider`], so repeat checks of the same root cost
+/// O(changed files) instead of a full re-walk.
+pub fn watched_engine(client: reqwest::Client) -> DefaultSyncEngine {
+    DefaultSyncEngine::new_watched(client)
+}
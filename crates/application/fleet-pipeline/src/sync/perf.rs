@@ -0,0 +1,68 @@
+//! Machine-readable performance report for a sync run.
+//!
+//! Deployments diff these across machines to answer "why was this sync
+//! slow?": which phase dominated, whether the scan cache was effective, how
+//! much time the rate limiter cost, and which files dragged the tail.
+
+use serde::Serialize;
+use std::time::Duration;
+
+/// How many of the slowest downloads the report keeps.
+const SLOWEST_N: usize = 10;
+
+/// One timed phase of a sync, with throughput when the phase moved bytes.
+#[derive(Debug, Clone, Default, Serialize)]
+pub struct PhasePerf {
+    pub duration_ms: u64,
+    pub bytes: u64,
+    pub bytes_per_sec: u64,
+}
+
+impl PhasePerf {
+    pub fn new(elapsed: Duration, bytes: u64) -> Self {
+        let secs = elapsed.as_secs_f64();
+        Self {
+            duration_ms: elapsed.as_millis() as u64,
+            bytes,
+            bytes_per_sec: if secs > 0.0 {
+                (bytes as f64 / secs) as u64
+            } else {
+                0
+            },
+        }
+    }
+}
+
+/// Wall time one download spent in a concurrency slot, including
+/// verification.
+#[derive(Debug, Clone, Serialize)]
+pub struct DownloadTiming {
+    pub path: String,
+    pub bytes: u64,
+    pub duration_ms: u64,
+}
+
+/// Emitted at the end of `plan_and_execute`; serializes to the JSON the CLI
+/// prints under `--perf-report`.
+#[derive(Debug, Clone, Default, Serialize)]
+pub struct SyncPerfReport {
+    pub total: PhasePerf,
+    pub fetch: PhasePerf,
+    pub scan: PhasePerf,
+    pub diff: PhasePerf,
+    pub execute: PhasePerf,
+    pub scan_files_total: u64,
+    pub scan_files_cached: u64,
+    pub scan_cache_hit_rate: f64,
+    pub limiter_wait_ms: u64,
+    pub slowest_downloads: Vec<DownloadTiming>,
+}
+
+impl SyncPerfReport {
+    /// Top [`SLOWEST_N`] timings by duration, in descending order.
+    pub(crate) fn keep_slowest(mut timings: Vec<DownloadTiming>) -> Vec<DownloadTiming> {
+        timings.sort_by(|a, b| b.duration_ms.cmp(&a.duration_ms));
+        timings.truncate(SLOWEST_N);
+        timings
+    }
+}
@@ -1,6 +1,7 @@
 use fleet_core::SyncPlan;
-use fleet_infra::net::DownloadEvent;
+use fleet_infra::net::{DownloadEvent, ProgressTable};
 use std::collections::{HashMap, VecDeque};
+use std::sync::Arc;
 use std::time::Instant;
 
 #[derive(Debug, Clone)]
@@ -36,6 +37,11 @@ pub struct ProgressTracker {
     bytes_since_last_tick: u64,
     speed_bps: u64,
     history: VecDeque<u64>,
+    /// Byte counters written by the downloader when progress flows through a
+    /// shared table instead of `Progress` events.
+    table: Option<Arc<ProgressTable>>,
+    /// Last per-id totals read from the table, so reads convert to deltas.
+    sampled: HashMap<u64, u64>,
 }
 
 impl ProgressTracker {
@@ -61,6 +67,37 @@ impl ProgressTracker {
             bytes_since_last_tick: 0,
             speed_bps: 0,
             history: VecDeque::new(),
+            table: None,
+            sampled: HashMap::new(),
+        }
+    }
+
+    /// Tracker for a downloader that reports bytes through `table`; byte
+    /// counts are pulled on every [`get_snapshot`](Self::get_snapshot) call
+    /// instead of arriving as `Progress` events.
+    pub fn with_table(plan: &SyncPlan, table: Arc<ProgressTable>) -> Self {
+        let mut tracker = Self::new(plan);
+        tracker.table = Some(table);
+        tracker
+    }
+
+    /// Fold the table's running total for `id` into the byte accounting as a
+    /// delta against what was already seen.
+    fn sample(&mut self, id: u64) {
+        let Some(table) = &self.table else {
+            return;
+        };
+        let total = table.bytes(id);
+        let seen = self.sampled.entry(id).or_insert(0);
+        let delta = total.saturating_sub(*seen);
+        if delta == 0 {
+            return;
+        }
+        *seen = total;
+        self.bytes_since_last_tick += delta;
+        self.current_downloaded_bytes += delta;
+        if let Some(entry) = self.in_flight.get_mut(&id) {
+            entry.bytes_downloaded += delta;
         }
     }
 
@@ -94,17 +131,30 @@ impl ProgressTracker {
                 }
             }
             DownloadEvent::Completed { id, success } => {
+                // Catch any bytes reported to the table since the last tick.
+                self.sample(id);
                 self.in_flight.remove(&id);
+                self.sampled.remove(&id);
                 if success {
                     self.downloaded_files += 1;
                 } else {
                     self.failed_count += 1;
                 }
             }
+            // Mod completion is informational; per-file accounting above
+            // already covers the totals.
+            DownloadEvent::ModCompleted { .. } => {}
         }
     }
 
     pub fn get_snapshot(&mut self) -> TransferSnapshot {
+        if self.table.is_some() {
+            let ids: Vec<u64> = self.in_flight.keys().copied().collect();
+            for id in ids {
+                self.sample(id);
+            }
+        }
+
         let now = Instant::now();
         let elapsed = now.duration_since(self.last_tick).as_secs_f64();
 
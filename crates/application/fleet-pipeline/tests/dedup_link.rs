@@ -0,0 +1,160 @@
+use camino::Utf8PathBuf;
+use fleet_core::{DownloadAction, SyncPlan};
+use fleet_persistence::{FleetDataStore, LocalFileSummary, LocalManifestSummary, RedbFleetDataStore};
+use fleet_pipeline::sync::execute::{DefaultPlanExecutor, PlanExecutor};
+use fleet_pipeline::sync::SyncOptions;
+
+fn utf8_root(dir: &tempfile::TempDir) -> Utf8PathBuf {
+    Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap()
+}
+
+fn mtime_of(path: &Utf8PathBuf) -> u64 {
+    let meta = std::fs::metadata(path.as_std_path()).unwrap();
+    meta.modified()
+        .unwrap()
+        .duration_since(std::time::UNIX_EPOCH)
+        .unwrap()
+        .as_secs()
+}
+
+/// A file another profile already holds verified is linked into place; the
+/// unreachable repo URL proves no download was attempted for it.
+#[tokio::test]
+async fn shared_file_is_linked_from_other_profile_instead_of_downloaded() {
+    let source_dir = tempfile::tempdir().unwrap();
+    let source_root = utf8_root(&source_dir);
+    let payload = b"shared-mod-content".to_vec();
+    std::fs::create_dir_all(source_root.join("@shared/addons")).unwrap();
+    let source_file = source_root.join("@shared/addons/data.pbo");
+    std::fs::write(&source_file, &payload).unwrap();
+
+    // The source profile's baseline summary is what vouches for the copy.
+    let store = RedbFleetDataStore;
+    store
+        .commit_repair_snapshot(
+            &source_root,
+            &fleet_core::Manifest {
+                version: "1.0".into(),
+                mods: vec![],
+            },
+            &[LocalManifestSummary {
+                mod_name: "@shared".into(),
+                files: vec![LocalFileSummary {
+                    rel_path: "addons/data.pbo".into(),
+                    mtime: mtime_of(&source_file),
+                    size: payload.len() as u64,
+                    checksum: "SHAREDSUM".into(),
+                }],
+            }],
+        )
+        .unwrap();
+
+    let target_dir = tempfile::tempdir().unwrap();
+    let target_root = utf8_root(&target_dir);
+
+    let plan = SyncPlan {
+        renames: vec![],
+        checks: vec![],
+        downloads: vec![DownloadAction {
+            mod_name: "@shared".into(),
+            rel_path: "addons/data.pbo".into(),
+            size: payload.len() as u64,
+            expected_checksum: "SHAREDSUM".into(),
+            delta: None,
+        }],
+        deletes: vec![],
+    };
+
+    let opts = SyncOptions {
+        dedup_roots: vec![source_root.clone()],
+        ..Default::default()
+    };
+
+    let executor = DefaultPlanExecutor::new(reqwest::Client::new());
+    let (artifacts, stats) = executor
+        .execute(&target_root, "http://127.0.0.1:9/", plan, &opts, None)
+        .await
+        .expect("dedup execute failed");
+
+    assert_eq!(stats.files_linked, 1);
+    assert_eq!(stats.bytes_linked, payload.len() as u64);
+    assert_eq!(stats.files_planned_download, 0);
+    assert_eq!(artifacts.len(), 1);
+    assert_eq!(artifacts[0].checksum, "SHAREDSUM");
+
+    let target_file = target_root.join("@shared/addons/data.pbo");
+    assert_eq!(std::fs::read(target_file.as_std_path()).unwrap(), payload);
+
+    #[cfg(unix)]
+    {
+        use std::os::unix::fs::MetadataExt;
+        // Same filesystem (both tempdirs): the copies share an inode.
+        assert_eq!(
+            std::fs::metadata(source_file.as_std_path()).unwrap().ino(),
+            std::fs::metadata(target_file.as_std_path()).unwrap().ino()
+        );
+    }
+}
+
+/// A stale source (content modified since its summary was committed) must
+/// not be linked; the plan falls back to downloading, which here fails
+/// against the unreachable URL.
+#[tokio::test]
+async fn modified_source_copy_is_not_trusted_for_linking() {
+    let source_dir = tempfile::tempdir().unwrap();
+    let source_root = utf8_root(&source_dir);
+    std::fs::create_dir_all(source_root.join("@shared")).unwrap();
+    let source_file = source_root.join("@shared/data.pbo");
+    std::fs::write(&source_file, b"original").unwrap();
+
+    let store = RedbFleetDataStore;
+    store
+        .commit_repair_snapshot(
+            &source_root,
+            &fleet_core::Manifest {
+                version: "1.0".into(),
+                mods: vec![],
+            },
+            &[LocalManifestSummary {
+                mod_name: "@shared".into(),
+                files: vec![LocalFileSummary {
+                    rel_path: "data.pbo".into(),
+                    mtime: mtime_of(&source_file),
+                    size: 8,
+                    checksum: "SHAREDSUM".into(),
+                }],
+            }],
+        )
+        .unwrap();
+
+    // Same checksum on record, different bytes on disk (size mismatch).
+    std::fs::write(&source_file, b"tampered-content").unwrap();
+
+    let target_dir = tempfile::tempdir().unwrap();
+    let target_root = utf8_root(&target_dir);
+    let plan = SyncPlan {
+        renames: vec![],
+        checks: vec![],
+        downloads: vec![DownloadAction {
+            mod_name: "@shared".into(),
+            rel_path: "data.pbo".into(),
+            size: 8,
+            expected_checksum: "SHAREDSUM".into(),
+            delta: None,
+        }],
+        deletes: vec![],
+    };
+    let opts = SyncOptions {
+        dedup_roots: vec![source_root],
+        ..Default::default()
+    };
+
+    let executor = DefaultPlanExecutor::new(reqwest::Client::new());
+    let res = executor
+        .execute(&target_root, "http://127.0.0.1:9/", plan, &opts, None)
+        .await;
+
+    // The download path was taken (and fails against the dead URL).
+    assert!(res.is_err());
+    assert!(!target_root.join("@shared/data.pbo").exists());
+}
@@ -0,0 +1,272 @@
+use axum::extract::State;
+use axum::http::{HeaderMap, StatusCode};
+use axum::response::{IntoResponse, Response};
+use axum::{body::Body, routing::get, Router};
+use camino::Utf8Path;
+use fleet_pipeline::sync::{default_engine, SyncMode, SyncOptions, SyncRequest};
+use std::net::SocketAddr;
+use std::sync::{Arc, Mutex};
+use tempfile::tempdir;
+
+// --- Tiny PBO builder (mirrors the header layout `parse_pbo_metadata` reads) ---
+
+fn build_pbo(entries: &[(&str, Vec<u8>)]) -> Vec<u8> {
+    let mut out = Vec::new();
+    for (name, data) in entries {
+        out.extend_from_slice(name.as_bytes());
+        out.push(0);
+        out.extend_from_slice(&0u32.to_le_bytes()); // type
+        out.extend_from_slice(&(data.len() as u32).to_le_bytes()); // original_size
+        out.extend_from_slice(&0u32.to_le_bytes()); // offset
+        out.extend_from_slice(&0u32.to_le_bytes()); // timestamp
+        out.extend_from_slice(&(data.len() as u32).to_le_bytes()); // data_size
+    }
+    // Terminator: empty name + five zero u32s
+    out.push(0);
+    out.extend_from_slice(&[0u8; 20]);
+    for (_, data) in entries {
+        out.extend_from_slice(data);
+    }
+    out
+}
+
+fn scan_pbo_bytes(bytes: &[u8], rel_path: &str) -> fleet_core::File {
+    let dir = tempdir().unwrap();
+    let fs_path = dir.path().join("pack.pbo");
+    std::fs::write(&fs_path, bytes).unwrap();
+    let utf = Utf8Path::from_path(&fs_path).unwrap();
+    fleet_infra::hashing::scan_file(utf, Utf8Path::new(rel_path)).unwrap()
+}
+
+// --- Range-aware test server ---
+
+#[derive(Clone)]
+struct ServerState {
+    repo_json: Arc<Mutex<String>>,
+    mod_srf: Arc<Mutex<String>>,
+    file_bytes: Arc<Mutex<Vec<u8>>>,
+    range_requests: Arc<Mutex<Vec<String>>>,
+}
+
+async fn serve_file(State(state): State<ServerState>, headers: HeaderMap) -> Response {
+    let data = state.file_bytes.lock().unwrap().clone();
+
+    if let Some(range) = headers.get("range").and_then(|v| v.to_str().ok()) {
+        state
+            .range_requests
+            .lock()
+            .unwrap()
+            .push(range.to_string());
+        let spec = range.trim_start_matches("bytes=");
+        if let Some((start, end)) = spec.split_once('-') {
+            let start: usize = start.parse().unwrap();
+            let end: usize = end.parse().unwrap();
+            let slice = data[start..=end].to_vec();
+            return (StatusCode::PARTIAL_CONTENT, slice).into_response();
+        }
+    }
+
+    Body::from(data).into_response()
+}
+
+async fn start_server(state: ServerState) -> (SocketAddr, tokio::task::JoinHandle<()>) {
+    let repo_state = state.clone();
+    let srf_state = state.clone();
+
+    let app = Router::new()
+        .route(
+            "/repo.json",
+            get(move || {
+                let body = repo_state.repo_json.lock().unwrap().clone();
+                async move { Body::from(body) }
+            }),
+        )
+        .route(
+            "/@tiny/mod.srf",
+            get(move || {
+                let body = srf_state.mod_srf.lock().unwrap().clone();
+                async move { Body::from(body) }
+            }),
+        )
+        .route("/@tiny/addons/pack.pbo", get(serve_file))
+        .with_state(state);
+
+    let listener = tokio::net::TcpListener::bind("127.0.0.1:0").await.unwrap();
+    let addr = listener.local_addr().unwrap();
+    let handle = tokio::spawn(async move {
+        axum::serve(listener, app).await.unwrap();
+    });
+    (addr, handle)
+}
+
+fn repo_json(mod_checksum: &str) -> String {
+    format!(
+        r#"{{
+        "repoName": "tiny",
+        "checksum": "{mod_checksum}",
+        "requiredMods": [{{"modName": "@tiny", "checksum": "{mod_checksum}", "enabled": true}}],
+        "optionalMods": []
+    }}"#
+    )
+}
+
+fn mod_srf(file: &fleet_core::File, mod_checksum: &str) -> String {
+    let m = fleet_core::Mod {
+        name: "@tiny".to_string(),
+        checksum: mod_checksum.to_string(),
+        files: vec![file.clone()],
+    };
+    serde_json::to_string(&m).unwrap()
+}
+
+#[tokio::test]
+async fn changed_pbo_entry_is_fetched_via_range_requests() {
+    // v1: three entries. v2: only the middle entry changes.
+    let unchanged_a = vec![b'A'; 3000];
+    let unchanged_c = vec![b'C'; 4000];
+    let pbo_v1 = build_pbo(&[
+        ("a.bin", unchanged_a.clone()),
+        ("b.bin", vec![b'B'; 2000]),
+        ("c.bin", unchanged_c.clone()),
+    ]);
+    let pbo_v2 = build_pbo(&[
+        ("a.bin", unchanged_a),
+        ("b.bin", vec![b'X'; 2000]),
+        ("c.bin", unchanged_c),
+    ]);
+
+    let file_v1 = scan_pbo_bytes(&pbo_v1, "addons/pack.pbo");
+    let file_v2 = scan_pbo_bytes(&pbo_v2, "addons/pack.pbo");
+
+    let state = ServerState {
+        repo_json: Arc::new(Mutex::new(repo_json("V1"))),
+        mod_srf: Arc::new(Mutex::new(mod_srf(&file_v1, "V1"))),
+        file_bytes: Arc::new(Mutex::new(pbo_v1.clone())),
+        range_requests: Arc::new(Mutex::new(Vec::new())),
+    };
+    let (addr, handle) = start_server(state.clone()).await;
+    let base_url = format!("http://{addr}");
+
+    let dir = tempdir().unwrap();
+    let root = camino::Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+
+    let engine = default_engine(reqwest::Client::new());
+
+    // Initial sync: full download of v1.
+    let req = SyncRequest {
+        repo_url: base_url.clone(),
+        local_root: root.clone(),
+        mode: SyncMode::SmartVerify,
+        options: SyncOptions::default(),
+        profile_id: None,
+    };
+    let result = engine.plan_and_execute(&req, None).await.unwrap();
+    assert!(result.executed);
+    assert!(state.range_requests.lock().unwrap().is_empty());
+
+    // Publish v2 and sync again via the baseline-aware fast check.
+    *state.repo_json.lock().unwrap() = repo_json("V2");
+    *state.mod_srf.lock().unwrap() = mod_srf(&file_v2, "V2");
+    *state.file_bytes.lock().unwrap() = pbo_v2.clone();
+
+    let req = SyncRequest {
+        repo_url: base_url,
+        local_root: root.clone(),
+        mode: SyncMode::FastCheck,
+        options: SyncOptions::default(),
+        profile_id: None,
+    };
+    let result = engine.plan_and_execute(&req, None).await.unwrap();
+    assert!(result.executed);
+
+    // The unchanged entries must have been spliced locally: only Range
+    // requests hit the wire, and they cover less than the whole file.
+    let ranges = state.range_requests.lock().unwrap().clone();
+    assert!(!ranges.is_empty(), "expected Range requests, got none");
+
+    let on_disk = std::fs::read(root.join("@tiny/addons/pack.pbo")).unwrap();
+    assert_eq!(on_disk, pbo_v2);
+
+    handle.abort();
+}
+
+#[tokio::test]
+async fn delta_falls_back_to_full_download_without_range_support() {
+    let pbo_v1 = build_pbo(&[("a.bin", vec![b'A'; 3000]), ("b.bin", vec![b'B'; 2000])]);
+    let pbo_v2 = build_pbo(&[("a.bin", vec![b'A'; 3000]), ("b.bin", vec![b'X'; 2000])]);
+
+    let file_v1 = scan_pbo_bytes(&pbo_v1, "addons/pack.pbo");
+    let file_v2 = scan_pbo_bytes(&pbo_v2, "addons/pack.pbo");
+
+    let state = ServerState {
+        repo_json: Arc::new(Mutex::new(repo_json("V1"))),
+        mod_srf: Arc::new(Mutex::new(mod_srf(&file_v1, "V1"))),
+        file_bytes: Arc::new(Mutex::new(pbo_v1.clone())),
+        range_requests: Arc::new(Mutex::new(Vec::new())),
+    };
+
+    // Same routes, but the file handler ignores Range and always sends 200.
+    let file_state = state.clone();
+    let repo_state = state.clone();
+    let srf_state = state.clone();
+    let app = Router::new()
+        .route(
+            "/repo.json",
+            get(move || {
+                let body = repo_state.repo_json.lock().unwrap().clone();
+                async move { Body::from(body) }
+            }),
+        )
+        .route(
+            "/@tiny/mod.srf",
+            get(move || {
+                let body = srf_state.mod_srf.lock().unwrap().clone();
+                async move { Body::from(body) }
+            }),
+        )
+        .route(
+            "/@tiny/addons/pack.pbo",
+            get(move || {
+                let data = file_state.file_bytes.lock().unwrap().clone();
+                async move { Body::from(data) }
+            }),
+        );
+    let listener = tokio::net::TcpListener::bind("127.0.0.1:0").await.unwrap();
+    let addr = listener.local_addr().unwrap();
+    let handle = tokio::spawn(async move {
+        axum::serve(listener, app).await.unwrap();
+    });
+    let base_url = format!("http://{addr}");
+
+    let dir = tempdir().unwrap();
+    let root = camino::Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+    let engine = default_engine(reqwest::Client::new());
+
+    let req = SyncRequest {
+        repo_url: base_url.clone(),
+        local_root: root.clone(),
+        mode: SyncMode::SmartVerify,
+        options: SyncOptions::default(),
+        profile_id: None,
+    };
+    engine.plan_and_execute(&req, None).await.unwrap();
+
+    *state.repo_json.lock().unwrap() = repo_json("V2");
+    *state.mod_srf.lock().unwrap() = mod_srf(&file_v2, "V2");
+    *state.file_bytes.lock().unwrap() = pbo_v2.clone();
+
+    let req = SyncRequest {
+        repo_url: base_url,
+        local_root: root.clone(),
+        mode: SyncMode::FastCheck,
+        options: SyncOptions::default(),
+        profile_id: None,
+    };
+    let result = engine.plan_and_execute(&req, None).await.unwrap();
+    assert!(result.executed);
+
+    let on_disk = std::fs::read(root.join("@tiny/addons/pack.pbo")).unwrap();
+    assert_eq!(on_disk, pbo_v2);
+
+    handle.abort();
+}
@@ -31,6 +31,7 @@ async fn fast_check_detects_mtime_change() {
                 checksum: "checksum_orig".into(),
                 file_type: fleet_core::FileType::File,
                 parts: vec![],
+                canonical: Default::default(),
             }],
         }],
     };
@@ -45,6 +46,7 @@ async fn fast_check_detects_mtime_change() {
                 mtime,
                 size: len,
                 checksum: "checksum_orig".into(),
+                fast_checksum: String::new(),
             }],
         )
         .unwrap();
@@ -99,6 +101,7 @@ async fn fast_check_detects_size_change() {
                 checksum: "checksum_orig".into(),
                 file_type: fleet_core::FileType::File,
                 parts: vec![],
+                canonical: Default::default(),
             }],
         }],
     };
@@ -113,6 +116,7 @@ async fn fast_check_detects_size_change() {
                 mtime,
                 size: len,
                 checksum: "checksum_orig".into(),
+                fast_checksum: String::new(),
             }],
         )
         .unwrap();
@@ -157,6 +161,7 @@ async fn fast_check_handles_missing_file() {
                 checksum: "checksum_orig".into(),
                 file_type: fleet_core::FileType::File,
                 parts: vec![],
+                canonical: Default::default(),
             }],
         }],
     };
@@ -171,6 +176,7 @@ async fn fast_check_handles_missing_file() {
                 mtime,
                 size: len,
                 checksum: "checksum_orig".into(),
+                fast_checksum: String::new(),
             }],
         )
         .unwrap();
@@ -0,0 +1,142 @@
+use axum::http::header::LAST_MODIFIED;
+use axum::response::IntoResponse;
+use axum::{routing::head, Router};
+use fleet_persistence::RedbFleetDataStore;
+use fleet_pipeline::sync::execute::DefaultPlanExecutor;
+use fleet_pipeline::sync::local::DefaultLocalStateProvider;
+use fleet_pipeline::sync::remote::HttpRemoteStateProvider;
+use fleet_pipeline::sync::storage::{RepoSummary, RepoSummaryStore};
+use fleet_pipeline::{DefaultSyncEngine, RemoteFreshness};
+use std::collections::HashMap;
+use std::net::SocketAddr;
+use std::sync::{Arc, Mutex};
+
+const MTIME: &str = "Wed, 21 Oct 2015 07:28:00 GMT";
+
+/// In-memory summary store so the probe tests control exactly what the last
+/// full fetch "persisted" without touching the real config dir.
+#[derive(Default)]
+struct MemRepoSummaryStore(Mutex<HashMap<String, RepoSummary>>);
+
+impl RepoSummaryStore for MemRepoSummaryStore {
+    fn load_repo_summary(&self, profile_id: &str) -> Result<Option<RepoSummary>, String> {
+        Ok(self.0.lock().unwrap().get(profile_id).cloned())
+    }
+
+    fn save_repo_summary(&self, profile_id: &str, summary: &RepoSummary) -> Result<(), String> {
+        self.0
+            .lock()
+            .unwrap()
+            .insert(profile_id.to_string(), summary.clone());
+        Ok(())
+    }
+}
+
+async fn head_with_mtime() -> impl IntoResponse {
+    ([(LAST_MODIFIED, MTIME)], "")
+}
+
+async fn head_without_mtime() -> impl IntoResponse {
+    ""
+}
+
+async fn start_server(expose_mtime: bool) -> (SocketAddr, tokio::task::JoinHandle<()>) {
+    let app = if expose_mtime {
+        Router::new().route("/repo.json", head(head_with_mtime))
+    } else {
+        Router::new().route("/repo.json", head(head_without_mtime))
+    };
+    let listener = tokio::net::TcpListener::bind("127.0.0.1:0").await.unwrap();
+    let addr = listener.local_addr().unwrap();
+    let handle = tokio::spawn(async move {
+        axum::serve(listener, app).await.unwrap();
+    });
+    (addr, handle)
+}
+
+fn engine_with(store: Arc<dyn RepoSummaryStore>) -> DefaultSyncEngine {
+    let client = reqwest::Client::new();
+    let fleet_data: Arc<dyn fleet_persistence::FleetDataStore> = Arc::new(RedbFleetDataStore);
+    DefaultSyncEngine::with_components(
+        Box::new(HttpRemoteStateProvider::new(client.clone())),
+        Box::new(DefaultLocalStateProvider::new(fleet_data.clone())),
+        Box::new(DefaultPlanExecutor::new(client)),
+        fleet_data,
+        store,
+    )
+}
+
+#[tokio::test]
+async fn matching_persisted_mtime_probes_unchanged() {
+    let store = Arc::new(MemRepoSummaryStore::default());
+    store
+        .save_repo_summary(
+            "p1",
+            &RepoSummary {
+                last_modified: Some(MTIME.to_string()),
+                repo_json: "{}".into(),
+            },
+        )
+        .unwrap();
+
+    let (addr, server) = start_server(true).await;
+    let engine = engine_with(store);
+
+    let freshness = engine
+        .probe_remote_freshness(&format!("http://{addr}"), "p1")
+        .await;
+    assert_eq!(freshness, RemoteFreshness::Unchanged);
+
+    server.abort();
+}
+
+#[tokio::test]
+async fn stale_or_missing_summary_probes_changed() {
+    let store = Arc::new(MemRepoSummaryStore::default());
+    store
+        .save_repo_summary(
+            "stale",
+            &RepoSummary {
+                last_modified: Some("Mon, 01 Jan 2001 00:00:00 GMT".into()),
+                repo_json: "{}".into(),
+            },
+        )
+        .unwrap();
+
+    let (addr, server) = start_server(true).await;
+    let engine = engine_with(store);
+    let repo_url = format!("http://{addr}");
+
+    assert_eq!(
+        engine.probe_remote_freshness(&repo_url, "stale").await,
+        RemoteFreshness::Changed
+    );
+    assert_eq!(
+        engine.probe_remote_freshness(&repo_url, "never-fetched").await,
+        RemoteFreshness::Changed
+    );
+
+    server.abort();
+}
+
+#[tokio::test]
+async fn missing_header_or_dead_server_probes_unknown() {
+    let store = Arc::new(MemRepoSummaryStore::default());
+    let (addr, server) = start_server(false).await;
+    let engine = engine_with(store);
+
+    assert_eq!(
+        engine
+            .probe_remote_freshness(&format!("http://{addr}"), "p1")
+            .await,
+        RemoteFreshness::Unknown
+    );
+    assert_eq!(
+        engine
+            .probe_remote_freshness("http://127.0.0.1:9/", "p1")
+            .await,
+        RemoteFreshness::Unknown
+    );
+
+    server.abort();
+}
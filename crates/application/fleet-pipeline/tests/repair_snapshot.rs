@@ -21,6 +21,7 @@ fn repair_persists_local_baseline_manifest_and_summary() {
                 checksum: "ABC".into(),
                 file_type: fleet_core::FileType::File,
                 parts: vec![],
+                canonical: Default::default(),
             }],
         }],
     };
@@ -26,6 +26,7 @@ async fn execute_blocks_directory_traversal() {
             rel_path: "../../../etc/passwd".into(),
             size: 123,
             expected_checksum: "abc".into(),
+            delta: None,
         }],
         deletes: vec![],
         renames: vec![],
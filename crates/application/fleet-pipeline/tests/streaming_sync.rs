@@ -0,0 +1,117 @@
+use axum::{body::Body, routing::get, Router};
+use camino::Utf8Path;
+use fleet_pipeline::sync::{default_engine, SyncMode, SyncOptions, SyncRequest};
+use std::net::SocketAddr;
+use tempfile::tempdir;
+
+fn scan_bytes(bytes: &[u8], rel_path: &str) -> fleet_core::File {
+    let dir = tempdir().unwrap();
+    let fs_path = dir.path().join("file.bin");
+    std::fs::write(&fs_path, bytes).unwrap();
+    let utf = Utf8Path::from_path(&fs_path).unwrap();
+    fleet_infra::hashing::scan_file(utf, Utf8Path::new(rel_path)).unwrap()
+}
+
+fn mod_srf(name: &str, files: &[fleet_core::File]) -> String {
+    let m = fleet_core::Mod {
+        name: name.to_string(),
+        checksum: format!("{name}-V1"),
+        files: files.to_vec(),
+    };
+    serde_json::to_string(&m).unwrap()
+}
+
+async fn start_server(
+    routes: Vec<(String, Vec<u8>)>,
+) -> (SocketAddr, tokio::task::JoinHandle<()>) {
+    let mut app = Router::new();
+    for (path, body) in routes {
+        app = app.route(
+            &path,
+            get(move || {
+                let body = body.clone();
+                async move { Body::from(body) }
+            }),
+        );
+    }
+    let listener = tokio::net::TcpListener::bind("127.0.0.1:0").await.unwrap();
+    let addr = listener.local_addr().unwrap();
+    let handle = tokio::spawn(async move {
+        axum::serve(listener, app).await.unwrap();
+    });
+    (addr, handle)
+}
+
+#[tokio::test]
+async fn streaming_sync_downloads_fresh_mods_and_settles_clean() {
+    let file_a = b"alpha content".to_vec();
+    let file_b = b"bravo content, a bit longer".to_vec();
+    let scanned_a = scan_bytes(&file_a, "a.bin");
+    let scanned_b = scan_bytes(&file_b, "data/b.bin");
+
+    let repo_json = format!(
+        r#"{{
+        "repoName": "tiny",
+        "checksum": "V1",
+        "requiredMods": [
+            {{"modName": "@alpha", "checksum": "@alpha-V1", "enabled": true}},
+            {{"modName": "@bravo", "checksum": "@bravo-V1", "enabled": true}}
+        ],
+        "optionalMods": []
+    }}"#
+    );
+
+    let (addr, handle) = start_server(vec![
+        ("/repo.json".into(), repo_json.into_bytes()),
+        (
+            "/@alpha/mod.srf".into(),
+            mod_srf("@alpha", std::slice::from_ref(&scanned_a)).into_bytes(),
+        ),
+        (
+            "/@bravo/mod.srf".into(),
+            mod_srf("@bravo", std::slice::from_ref(&scanned_b)).into_bytes(),
+        ),
+        ("/@alpha/a.bin".into(), file_a.clone()),
+        ("/@bravo/data/b.bin".into(), file_b.clone()),
+    ])
+    .await;
+    let base_url = format!("http://{addr}");
+
+    let dir = tempdir().unwrap();
+    let root = camino::Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+    // A pre-existing local mod that the repo no longer lists must be removed.
+    std::fs::create_dir_all(root.join("@stale")).unwrap();
+    std::fs::write(root.join("@stale/old.bin"), b"junk").unwrap();
+
+    let engine = default_engine(reqwest::Client::new());
+    let req = SyncRequest {
+        repo_url: base_url.clone(),
+        local_root: root.clone(),
+        mode: SyncMode::SmartVerify,
+        options: SyncOptions::default(),
+        profile_id: None,
+    };
+
+    let result = engine
+        .plan_and_execute_streaming(&req, None)
+        .await
+        .unwrap();
+    assert!(result.executed);
+    assert_eq!(result.plan.downloads.len(), 2);
+
+    assert_eq!(std::fs::read(root.join("@alpha/a.bin")).unwrap(), file_a);
+    assert_eq!(
+        std::fs::read(root.join("@bravo/data/b.bin")).unwrap(),
+        file_b
+    );
+    assert!(!root.join("@stale").exists());
+
+    // A second streaming sync finds nothing to do.
+    let result = engine
+        .plan_and_execute_streaming(&req, None)
+        .await
+        .unwrap();
+    assert!(!result.executed);
+
+    handle.abort();
+}
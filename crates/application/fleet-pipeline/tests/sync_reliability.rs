@@ -52,6 +52,7 @@ async fn execute_sync_then_fast_check_is_clean() {
             rel_path: "file.txt".into(),
             size: 7, // "content".len()
             expected_checksum: expected_checksum.clone(),
+            delta: None,
         }],
         deletes: vec![],
         renames: vec![],
@@ -0,0 +1,151 @@
+use camino::{Utf8Path, Utf8PathBuf};
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use fleet_scanner::cache::ScanCache;
+use fleet_scanner::{ScanCacheStore, ScanStrategy, Scanner, ScannerError};
+use std::collections::HashMap;
+use std::hint::black_box;
+use std::sync::{Arc, Mutex};
+
+/// Valid PBO bytes, mirroring the helper the hashing tests use; the
+/// production parser is the ground truth that the corpus is well-formed.
+fn build_pbo(entries: &[(String, Vec<u8>)], trailing: &[u8]) -> Vec<u8> {
+    let mut out = Vec::new();
+    for (name, data) in entries {
+        out.extend_from_slice(name.as_bytes());
+        out.push(0);
+        out.extend_from_slice(&0u32.to_le_bytes()); // type
+        out.extend_from_slice(&(data.len() as u32).to_le_bytes()); // original_size
+        out.extend_from_slice(&0u32.to_le_bytes()); // offset
+        out.extend_from_slice(&0u32.to_le_bytes()); // timestamp
+        out.extend_from_slice(&(data.len() as u32).to_le_bytes()); // data_size
+    }
+    out.push(0);
+    out.extend_from_slice(&[0u8; 20]);
+    for (_, data) in entries {
+        out.extend_from_slice(data);
+    }
+    out.extend_from_slice(trailing);
+    out
+}
+
+fn patterned(len: usize, seed: u8) -> Vec<u8> {
+    (0..len).map(|i| (i as u8).wrapping_mul(31).wrapping_add(seed)).collect()
+}
+
+/// Lays down `mods` mod directories, each with a handful of PBOs (varying
+/// entry sizes) and one raw file, and verifies one PBO parses through the
+/// production scanner before returning.
+fn synth_corpus(root: &Utf8Path, mods: usize, pbos_per_mod: usize) {
+    for m in 0..mods {
+        let addons = root.join(format!("@bench_mod_{m}")).join("addons");
+        std::fs::create_dir_all(&addons).unwrap();
+        for p in 0..pbos_per_mod {
+            let entries: Vec<(String, Vec<u8>)> = (0..8)
+                .map(|e| {
+                    (
+                        format!("data\\e_{e}.paa"),
+                        patterned(32 * 1024 * (1 + e % 4), (m + p + e) as u8),
+                    )
+                })
+                .collect();
+            let bytes = build_pbo(&entries, b"sig");
+            std::fs::write(addons.join(format!("pack_{p}.pbo")), bytes).unwrap();
+        }
+        std::fs::write(
+            root.join(format!("@bench_mod_{m}")).join("mod.cpp"),
+            format!("name = \"bench mod {m}\";"),
+        )
+        .unwrap();
+    }
+
+    let probe = root.join("@bench_mod_0/addons/pack_0.pbo");
+    let scanned =
+        fleet_infra::hashing::scan_file(&probe, Utf8Path::new("addons/pack_0.pbo")).unwrap();
+    assert_eq!(scanned.file_type, fleet_core::FileType::Pbo);
+}
+
+/// In-memory cache store so the warm-cache benchmark measures scan logic,
+/// not redb I/O.
+#[derive(Default)]
+struct MemCacheStore {
+    caches: Mutex<HashMap<String, ScanCache>>,
+}
+
+impl ScanCacheStore for MemCacheStore {
+    fn load_mod_cache(&self, mod_name: &str) -> Result<ScanCache, ScannerError> {
+        Ok(self
+            .caches
+            .lock()
+            .unwrap()
+            .get(mod_name)
+            .cloned()
+            .unwrap_or_default())
+    }
+
+    fn save_mod_cache(&self, mod_name: &str, cache: &ScanCache) -> Result<(), ScannerError> {
+        self.caches
+            .lock()
+            .unwrap()
+            .insert(mod_name.to_string(), cache.clone());
+        Ok(())
+    }
+}
+
+fn bench_scan_directory(c: &mut Criterion) {
+    let dir = tempfile::tempdir().unwrap();
+    let root = Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+    let (mods, pbos_per_mod) = (8usize, 12usize);
+    synth_corpus(&root, mods, pbos_per_mod);
+
+    let corpus_bytes: u64 = walkdir::WalkDir::new(&root)
+        .into_iter()
+        .filter_map(|e| e.ok())
+        .filter(|e| e.file_type().is_file())
+        .filter_map(|e| e.metadata().ok())
+        .map(|m| m.len())
+        .sum();
+
+    let mut group = c.benchmark_group("scan_directory");
+    group.sample_size(10);
+    group.throughput(Throughput::Bytes(corpus_bytes));
+
+    group.bench_function(BenchmarkId::new("force_rehash", mods * pbos_per_mod), |b| {
+        b.iter(|| {
+            black_box(
+                Scanner::scan_directory(&root, ScanStrategy::ForceRehash, None, None, None)
+                    .unwrap(),
+            )
+        })
+    });
+
+    let store: Arc<dyn ScanCacheStore> = Arc::new(MemCacheStore::default());
+    // Prime the cache so the measured runs take the mtime/size hit path.
+    Scanner::scan_directory(
+        &root,
+        ScanStrategy::SmartCache,
+        None,
+        Some(store.clone()),
+        None,
+    )
+    .unwrap();
+
+    group.bench_function(BenchmarkId::new("smart_cache_warm", mods * pbos_per_mod), |b| {
+        b.iter(|| {
+            black_box(
+                Scanner::scan_directory(
+                    &root,
+                    ScanStrategy::SmartCache,
+                    None,
+                    Some(store.clone()),
+                    None,
+                )
+                .unwrap(),
+            )
+        })
+    });
+
+    group.finish();
+}
+
+criterion_group!(benches, bench_scan_directory);
+criterion_main!(benches);
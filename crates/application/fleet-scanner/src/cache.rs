@@ -7,6 +7,9 @@ pub struct FileCacheEntry {
     pub mtime: u64,
     pub size: u64,
     pub checksum: String,
+    /// Fast local-verification digest (see `fleet_infra::hashing::fast_file_digest`).
+    /// Empty for entries written before the fast track existed.
+    pub fast_checksum: String,
 }
 
 #[derive(Debug, Default, Clone)]
@@ -18,12 +21,20 @@ pub struct ScanCache {
 
 impl ScanCache {
     /// Insert or update an entry. Returns true if something actually changed.
-    pub fn update(&mut self, rel_path: &str, mtime: u64, size: u64, checksum: String) {
+    pub fn update(
+        &mut self,
+        rel_path: &str,
+        mtime: u64,
+        size: u64,
+        checksum: String,
+        fast_checksum: String,
+    ) {
         let path_key = FleetPath::normalize(rel_path);
         let entry = FileCacheEntry {
             mtime,
             size,
             checksum,
+            fast_checksum,
         };
         self.entries.insert(path_key, entry);
         self.dirty = true;
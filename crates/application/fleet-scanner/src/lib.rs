@@ -10,6 +10,7 @@ use tracing::{debug, error, info, warn};
 use walkdir::WalkDir;
 
 pub mod cache;
+pub mod watch;
 use cache::ScanCache;
 
 #[derive(Debug, thiserror::Error)]
@@ -22,6 +23,8 @@ pub enum ScannerError {
     Hash(#[from] fleet_infra::hashing::ScanError),
     #[error("Cache error: {0}")]
     Cache(String),
+    #[error("Watch error: {0}")]
+    Watch(String),
 }
 
 #[derive(Debug, Clone, Copy)]
@@ -41,11 +44,60 @@ pub struct ScanStats {
     pub total_bytes: u64,
 }
 
+/// Counters shared across scan threads. The per-file hot path (especially
+/// cache hits) is a few relaxed atomic adds instead of a mutex acquisition,
+/// and the progress monitor reads a snapshot without blocking anyone.
+#[derive(Default)]
+struct SharedScanStats {
+    files_scanned: AtomicU64,
+    files_cached: AtomicU64,
+    total_files: AtomicU64,
+    bytes_processed: AtomicU64,
+    total_bytes: AtomicU64,
+}
+
+impl SharedScanStats {
+    fn snapshot(&self) -> ScanStats {
+        ScanStats {
+            files_scanned: self.files_scanned.load(Ordering::Relaxed),
+            files_cached: self.files_cached.load(Ordering::Relaxed),
+            total_files: self.total_files.load(Ordering::Relaxed),
+            bytes_processed: self.bytes_processed.load(Ordering::Relaxed),
+            total_bytes: self.total_bytes.load(Ordering::Relaxed),
+        }
+    }
+}
+
 struct ScanContext {
-    stats: Arc<Mutex<ScanStats>>,
+    stats: Arc<SharedScanStats>,
     cancel: Option<Arc<AtomicBool>>,
 }
 
+/// Per-mod scan state collected up front so the actual hashing can run over
+/// one flat queue of (mod, file) items instead of nested per-mod scopes.
+struct ModWork {
+    root: Utf8PathBuf,
+    name: String,
+    cache: ScanCache,
+    files: Vec<FileEntry>,
+}
+
+/// A file's identity and metadata, captured by the single stat the walk
+/// performs; scanning and cache update both reuse it instead of re-statting.
+struct FileEntry {
+    fs_path: Utf8PathBuf,
+    rel_path: String,
+    len: u64,
+    mtime: u64,
+}
+
+/// A scanned file plus its fast local-verification digest, which lives in
+/// the scan cache rather than on the domain `File`.
+struct ScannedFile {
+    file: File,
+    fast_checksum: String,
+}
+
 type ProgressCb = std::sync::Arc<Box<dyn Fn(ScanStats) + Send + Sync>>;
 
 pub trait ScanCacheStore: Send + Sync {
@@ -70,6 +122,22 @@ impl Scanner {
         on_progress: Option<Box<dyn Fn(ScanStats) + Send + Sync>>,
         cache_store: Option<Arc<dyn ScanCacheStore>>,
         cancel: Option<Arc<AtomicBool>>,
+    ) -> Result<Manifest, ScannerError> {
+        Self::scan_directory_streaming(root, strategy, on_progress, cache_store, cancel, |_| {})
+    }
+
+    /// Like [`scan_directory`](Self::scan_directory), but invokes
+    /// `on_mod_complete` from a worker thread the moment a mod's last file
+    /// finishes hashing, so callers can diff and download that mod while the
+    /// rest of the tree is still being scanned. Mods that fail to scan are
+    /// not emitted; the error surfaces in the returned result.
+    pub fn scan_directory_streaming(
+        root: &Utf8Path,
+        strategy: ScanStrategy,
+        on_progress: Option<Box<dyn Fn(ScanStats) + Send + Sync>>,
+        cache_store: Option<Arc<dyn ScanCacheStore>>,
+        cancel: Option<Arc<AtomicBool>>,
+        on_mod_complete: impl Fn(&Mod) + Send + Sync,
     ) -> Result<Manifest, ScannerError> {
         info!("Scanning {} ({:?})", root, strategy);
 
@@ -80,8 +148,101 @@ impl Scanner {
             .filter(|p| p.file_name().map(|n| n.starts_with('@')).unwrap_or(false))
             .collect();
 
+        let mods = Self::scan_mod_dirs(
+            mod_dirs,
+            strategy,
+            on_progress,
+            cache_store,
+            cancel,
+            on_mod_complete,
+            true,
+        )?;
+
+        Ok(Manifest {
+            version: "1.0".to_string(),
+            mods,
+        })
+    }
+
+    /// Like [`scan_directory_streaming`](Self::scan_directory_streaming), but
+    /// each `Mod` is dropped once the sink has seen it instead of being
+    /// collected into a `Manifest`. Peak memory is bounded by one in-flight
+    /// mod, which is what lets `scan --output` stream a 500k-file repo
+    /// without holding the whole manifest tree.
+    pub fn scan_directory_sink(
+        root: &Utf8Path,
+        strategy: ScanStrategy,
+        on_progress: Option<Box<dyn Fn(ScanStats) + Send + Sync>>,
+        cache_store: Option<Arc<dyn ScanCacheStore>>,
+        cancel: Option<Arc<AtomicBool>>,
+        on_mod_complete: impl Fn(&Mod) + Send + Sync,
+    ) -> Result<(), ScannerError> {
+        info!("Scanning {} ({:?}, sink mode)", root, strategy);
+
+        let mod_dirs: Vec<Utf8PathBuf> = fs::read_dir(root)?
+            .filter_map(|e| e.ok())
+            .filter(|e| e.path().is_dir())
+            .map(|e| Utf8PathBuf::from_path_buf(e.path().to_path_buf()).unwrap())
+            .filter(|p| p.file_name().map(|n| n.starts_with('@')).unwrap_or(false))
+            .collect();
+
+        Self::scan_mod_dirs(
+            mod_dirs,
+            strategy,
+            on_progress,
+            cache_store,
+            cancel,
+            on_mod_complete,
+            false,
+        )?;
+        Ok(())
+    }
+
+    /// Scans only the named mods under `root`, skipping names whose directory
+    /// no longer exists. This is the re-scan half of the watcher-backed
+    /// incremental mode: a filesystem watcher tells the caller which mods
+    /// changed, and this rebuilds just those `Mod` entries (updating their
+    /// scan caches on the way) so the cost is proportional to what changed.
+    pub fn scan_mods(
+        root: &Utf8Path,
+        mod_names: &[String],
+        strategy: ScanStrategy,
+        on_progress: Option<Box<dyn Fn(ScanStats) + Send + Sync>>,
+        cache_store: Option<Arc<dyn ScanCacheStore>>,
+        cancel: Option<Arc<AtomicBool>>,
+    ) -> Result<Vec<Mod>, ScannerError> {
+        let mod_dirs: Vec<Utf8PathBuf> = mod_names
+            .iter()
+            .map(|name| root.join(name))
+            .filter(|p| p.is_dir())
+            .collect();
+        Self::scan_mod_dirs(
+            mod_dirs,
+            strategy,
+            on_progress,
+            cache_store,
+            cancel,
+            |_| {},
+            true,
+        )
+    }
+
+    /// Shared scan core: hashes an explicit list of mod directories over one
+    /// flat work queue and assembles their `Mod` entries. With `retain_mods`
+    /// false, assembled mods are dropped right after `on_mod_complete` and
+    /// the returned vec is empty.
+    #[allow(clippy::too_many_arguments)]
+    fn scan_mod_dirs(
+        mod_dirs: Vec<Utf8PathBuf>,
+        strategy: ScanStrategy,
+        on_progress: Option<Box<dyn Fn(ScanStats) + Send + Sync>>,
+        cache_store: Option<Arc<dyn ScanCacheStore>>,
+        cancel: Option<Arc<AtomicBool>>,
+        on_mod_complete: impl Fn(&Mod) + Send + Sync,
+        retain_mods: bool,
+    ) -> Result<Vec<Mod>, ScannerError> {
         let ctx = Arc::new(ScanContext {
-            stats: Arc::new(Mutex::new(ScanStats::default())),
+            stats: Arc::new(SharedScanStats::default()),
             cancel: cancel.clone(),
         });
 
@@ -103,33 +264,113 @@ impl Scanner {
                             break;
                         }
                     }
-                    if let Ok(s) = stats_ref.lock() {
-                        (cb_clone)(s.clone());
-                    }
+                    (cb_clone)(stats_ref.snapshot());
                     thread::sleep(Duration::from_millis(100));
                 }
                 // Final update
-                if let Ok(s) = stats_ref.lock() {
-                    (cb_clone)(s.clone());
-                }
+                (cb_clone)(stats_ref.snapshot());
             });
             Some(done)
         } else {
             None
         };
 
-        // Parallel Scan
-        let results: Vec<Result<Mod, ScannerError>> = mod_dirs
+        // Collect every mod's file list up front, then scan one flat queue of
+        // (mod, file) items sorted largest-first. Nested per-mod scopes leave
+        // cores idle when the last remaining mod is one huge directory; the
+        // flat queue keeps the pool saturated until the final file finishes.
+        let mod_works: Result<Vec<ModWork>, ScannerError> = mod_dirs
             .par_iter()
-            .map(|mod_dir| {
-                if let Some(c) = &ctx.cancel {
-                    if c.load(Ordering::Relaxed) {
-                        return Err(ScannerError::Cancelled);
+            .map(|mod_dir| Self::collect_mod(mod_dir, strategy, cache_store.as_deref()))
+            .collect();
+        let mod_works = mod_works?;
+
+        // Pre-calculate totals
+        for work in &mod_works {
+            ctx.stats
+                .total_files
+                .fetch_add(work.files.len() as u64, Ordering::Relaxed);
+            ctx.stats.total_bytes.fetch_add(
+                work.files.iter().map(|f| f.len).sum::<u64>(),
+                Ordering::Relaxed,
+            );
+        }
+
+        let mut queue: Vec<(usize, &FileEntry)> = mod_works
+            .iter()
+            .enumerate()
+            .flat_map(|(idx, work)| work.files.iter().map(move |entry| (idx, entry)))
+            .collect();
+        queue.sort_unstable_by(|a, b| b.1.len.cmp(&a.1.len));
+
+        // Per-mod completion tracking: whichever worker finishes a mod's last
+        // file assembles that mod on the spot and hands it to the sink, while
+        // the queue keeps the rest of the pool busy.
+        let pending: Vec<AtomicU64> = mod_works
+            .iter()
+            .map(|w| AtomicU64::new(w.files.len() as u64))
+            .collect();
+        let collected: Vec<Mutex<Vec<ScannedFile>>> = mod_works
+            .iter()
+            .map(|w| Mutex::new(Vec::with_capacity(w.files.len())))
+            .collect();
+        let assembled: Vec<Mutex<Option<Result<Option<Mod>, ScannerError>>>> =
+            mod_works.iter().map(|_| Mutex::new(None)).collect();
+
+        let finish_mod = |mod_idx: usize| {
+            let files = std::mem::take(&mut *collected[mod_idx].lock().unwrap());
+            let mut slot = assembled[mod_idx].lock().unwrap();
+            // A slot already holding an error means a file in this mod failed;
+            // the partial mod is neither assembled nor emitted.
+            if slot.is_none() {
+                let res = Self::assemble_mod(&mod_works[mod_idx], files, cache_store.as_deref());
+                if let Ok(m) = &res {
+                    on_mod_complete(m);
+                }
+                *slot = Some(res.map(|m| retain_mods.then_some(m)));
+            }
+        };
+
+        // Mods with no files never pass through the queue.
+        for (idx, work) in mod_works.iter().enumerate() {
+            if work.files.is_empty() {
+                finish_mod(idx);
+            }
+        }
+
+        queue.par_iter().for_each(|&(mod_idx, entry)| {
+            let cancelled = ctx
+                .cancel
+                .as_ref()
+                .is_some_and(|c| c.load(Ordering::Relaxed));
+            let outcome = if cancelled {
+                Err(ScannerError::Cancelled)
+            } else {
+                Self::scan_one(entry, &mod_works[mod_idx], &ctx)
+            };
+            match outcome {
+                Ok(file) => collected[mod_idx].lock().unwrap().push(file),
+                Err(e) => {
+                    let mut slot = assembled[mod_idx].lock().unwrap();
+                    if slot.is_none() {
+                        *slot = Some(Err(e));
                     }
                 }
-                Self::scan_mod(mod_dir, strategy, &ctx, cache_store.as_deref())
-            })
-            .collect();
+            }
+            if pending[mod_idx].fetch_sub(1, Ordering::AcqRel) == 1 {
+                finish_mod(mod_idx);
+            }
+        });
+
+        let mut mods = Vec::with_capacity(if retain_mods { assembled.len() } else { 0 });
+        for slot in assembled {
+            match slot.into_inner().unwrap() {
+                Some(Ok(Some(m))) => mods.push(m),
+                Some(Ok(None)) => {}
+                Some(Err(e)) => return Err(e),
+                None => unreachable!("every mod is assembled or failed"),
+            }
+        }
 
         if let Some(done) = monitor {
             done.store(true, Ordering::Relaxed);
@@ -137,31 +378,21 @@ impl Scanner {
 
         // Ensure final synchronous callback so tests observe final stats immediately
         if let Some(cb_arc) = progress_cb {
-            if let Ok(s) = ctx.stats.lock() {
-                (cb_arc)(s.clone());
-            }
-        }
-
-        // Aggregate results
-        let mut mods = Vec::new();
-        for res in results {
-            mods.push(res?);
+            (cb_arc)(ctx.stats.snapshot());
         }
 
-        Ok(Manifest {
-            version: "1.0".to_string(),
-            mods,
-        })
+        Ok(mods)
     }
 
-    fn scan_mod(
+    /// Loads the mod's cache and walks its file list (with sizes) without
+    /// hashing anything yet.
+    fn collect_mod(
         mod_root: &Utf8Path,
         strategy: ScanStrategy,
-        ctx: &ScanContext,
         cache_store: Option<&dyn ScanCacheStore>,
-    ) -> Result<Mod, ScannerError> {
+    ) -> Result<ModWork, ScannerError> {
         let mod_name = mod_root.file_name().unwrap_or("unknown").to_string();
-        let mut cache = if matches!(strategy, ScanStrategy::ForceRehash) {
+        let cache = if matches!(strategy, ScanStrategy::ForceRehash) {
             ScanCache::default()
         } else if let Some(store) = cache_store {
             store.load_mod_cache(&mod_name)?
@@ -169,96 +400,152 @@ impl Scanner {
             ScanCache::default()
         };
 
-        // Collect files
-        let files: Vec<Utf8PathBuf> = WalkDir::new(mod_root)
+        // One stat per file: walkdir already holds the metadata, so size and
+        // mtime are captured here and reused by scanning and cache update.
+        let files: Vec<FileEntry> = WalkDir::new(mod_root)
             .into_iter()
             .filter_map(|e| e.ok())
             .filter(|e| e.file_type().is_file())
-            .map(|e| Utf8PathBuf::from_path_buf(e.path().to_path_buf()).unwrap())
-            .filter(|p| !p.as_str().contains(".git") && !p.file_name().unwrap().ends_with(".json"))
-            .collect();
-
-        // Pre-calculate totals
-        {
-            let mut stats = ctx.stats.lock().unwrap();
-            stats.total_files += files.len() as u64;
-            stats.total_bytes += files
-                .iter()
-                .filter_map(|p| fs::metadata(p).ok().map(|m| m.len()))
-                .sum::<u64>();
-        }
-
-        let scanned_files: Result<Vec<File>, ScannerError> = files
-            .par_iter()
-            .map(|fs_path| {
-                if let Some(c) = &ctx.cancel {
-                    if c.load(Ordering::Relaxed) {
-                        return Err(ScannerError::Cancelled);
-                    }
+            .filter_map(|e| {
+                let meta = e.metadata().ok()?;
+                let fs_path = Utf8PathBuf::from_path_buf(e.path().to_path_buf()).unwrap();
+                if fs_path.as_str().contains(".git")
+                    || fs_path.file_name().unwrap().ends_with(".json")
+                {
+                    return None;
                 }
-
-                let meta = fs::metadata(fs_path)?;
-                let len = meta.len();
-                let mtime = Self::mtime(&meta);
-
                 let rel_path =
                     FleetPath::normalize(fs_path.strip_prefix(mod_root).unwrap().as_str());
+                Some(FileEntry {
+                    fs_path,
+                    rel_path,
+                    len: meta.len(),
+                    mtime: Self::mtime(&meta),
+                })
+            })
+            .collect();
 
-                if let Some(entry) = cache.get(&rel_path) {
-                    if entry.mtime == mtime && entry.size == len {
-                        {
-                            let mut s = ctx.stats.lock().unwrap();
-                            s.files_scanned += 1;
-                            s.files_cached += 1;
-                            s.bytes_processed += len;
-                        }
-                        return Ok(File {
-                            path: rel_path,
-                            length: len,
-                            checksum: entry.checksum.clone(),
-                            file_type: FileType::File,
-                            parts: vec![],
+        Ok(ModWork {
+            root: mod_root.to_path_buf(),
+            name: mod_name,
+            cache,
+            files,
+        })
+    }
+
+    fn scan_one(
+        entry: &FileEntry,
+        work: &ModWork,
+        ctx: &ScanContext,
+    ) -> Result<ScannedFile, ScannerError> {
+        if let Some(cached) = work.cache.get(&entry.rel_path) {
+            if cached.mtime == entry.mtime && cached.size == entry.len {
+                ctx.stats.files_scanned.fetch_add(1, Ordering::Relaxed);
+                ctx.stats.files_cached.fetch_add(1, Ordering::Relaxed);
+                ctx.stats
+                    .bytes_processed
+                    .fetch_add(entry.len, Ordering::Relaxed);
+                return Ok(ScannedFile {
+                    file: File {
+                        path: entry.rel_path.clone(),
+                        length: entry.len,
+                        checksum: cached.checksum.clone(),
+                        file_type: FileType::File,
+                        parts: vec![],
+                        canonical: Default::default(),
+                    },
+                    fast_checksum: cached.fast_checksum.clone(),
+                });
+            }
+
+            // The mtime drifted but the content may be unchanged (extractors
+            // and copies touch timestamps all the time). An xxh3 pass runs at
+            // disk speed, so check the fast track before paying for MD5.
+            if cached.size == entry.len && !cached.fast_checksum.is_empty() {
+                if let Ok(fast) = fleet_infra::hashing::fast_file_digest(&entry.fs_path) {
+                    if fast == cached.fast_checksum {
+                        ctx.stats.files_scanned.fetch_add(1, Ordering::Relaxed);
+                        ctx.stats.files_cached.fetch_add(1, Ordering::Relaxed);
+                        ctx.stats
+                            .bytes_processed
+                            .fetch_add(entry.len, Ordering::Relaxed);
+                        return Ok(ScannedFile {
+                            file: File {
+                                path: entry.rel_path.clone(),
+                                length: entry.len,
+                                checksum: cached.checksum.clone(),
+                                file_type: FileType::File,
+                                parts: vec![],
+                                canonical: Default::default(),
+                            },
+                            fast_checksum: fast,
                         });
                     }
                 }
+            }
+        }
 
-                let file_obj = fleet_infra::hashing::scan_file(fs_path, Utf8Path::new(&rel_path))?;
-
-                {
-                    let mut s = ctx.stats.lock().unwrap();
-                    s.files_scanned += 1;
-                    s.bytes_processed += len;
-                }
+        let file_obj =
+            fleet_infra::hashing::scan_file(&entry.fs_path, Utf8Path::new(&entry.rel_path))?;
+        // The file's pages are still warm from the MD5 read, so recording the
+        // fast digest here is nearly free and seeds the fast track above.
+        let fast_checksum = fleet_infra::hashing::fast_file_digest(&entry.fs_path)
+            .unwrap_or_default();
+
+        ctx.stats.files_scanned.fetch_add(1, Ordering::Relaxed);
+        ctx.stats
+            .bytes_processed
+            .fetch_add(entry.len, Ordering::Relaxed);
+
+        Ok(ScannedFile {
+            file: file_obj,
+            fast_checksum,
+        })
+    }
 
-                Ok(file_obj)
-            })
+    fn assemble_mod(
+        work: &ModWork,
+        scanned_files: Vec<ScannedFile>,
+        cache_store: Option<&dyn ScanCacheStore>,
+    ) -> Result<Mod, ScannerError> {
+        let mut cache = work.cache.clone();
+
+        // Cache entries reuse the mtime captured by the walk. A file touched
+        // after that point gets a stale mtime, which simply forces a re-hash
+        // on the next scan (stat-after-hash had the unsafe inverse: a fresh
+        // mtime attached to a stale checksum).
+        let walk_mtimes: std::collections::HashMap<&str, u64> = work
+            .files
+            .iter()
+            .map(|entry| (entry.rel_path.as_str(), entry.mtime))
             .collect();
-
-        let scanned_files = scanned_files?;
-
-        for f in &scanned_files {
-            if let Ok(meta) = fs::metadata(mod_root.join(&f.path)) {
-                cache.update(&f.path, Self::mtime(&meta), f.length, f.checksum.clone());
+        for sf in &scanned_files {
+            if let Some(&mtime) = walk_mtimes.get(sf.file.path.as_str()) {
+                cache.update(
+                    &sf.file.path,
+                    mtime,
+                    sf.file.length,
+                    sf.file.checksum.clone(),
+                    sf.fast_checksum.clone(),
+                );
             }
         }
-        cache.prune_ghosts(mod_root);
+        cache.prune_ghosts(&work.root);
         if let Some(store) = cache_store {
-            store.save_mod_cache(&mod_name, &cache)?;
+            store.save_mod_cache(&work.name, &cache)?;
         }
 
         let mut hasher = md5::Context::new();
-        let mut sorted_files = scanned_files.clone();
-        sorted_files.sort_by(|a, b| {
-            FleetPath::canonicalize(&a.path).cmp(&FleetPath::canonicalize(&b.path))
-        });
+        let mut sorted_files: Vec<File> = scanned_files.into_iter().map(|sf| sf.file).collect();
+        sorted_files.sort_by(|a, b| a.canonical_path().cmp(b.canonical_path()));
 
         for file in &sorted_files {
             hasher.consume(file.checksum.as_bytes());
-            hasher.consume(FleetPath::canonicalize(&file.path).as_bytes());
+            hasher.consume(file.canonical_path().as_bytes());
         }
 
         Ok(Mod {
-            name: mod_name,
+            name: work.name.clone(),
             checksum: format!("{:X}", hasher.finalize()),
             files: sorted_files,
         })
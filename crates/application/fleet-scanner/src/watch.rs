@@ -0,0 +1,129 @@
+//! Filesystem change tracking for the watcher-backed incremental scan mode.
+//!
+//! A [`RootWatcher`] subscribes to change notifications under a profile root
+//! and folds every event down to the one thing the scanner cares about: the
+//! set of top-level `@mod` directories that were touched since the last
+//! [`drain`](RootWatcher::drain). Callers re-scan just those mods (via
+//! [`Scanner::scan_mods`](crate::Scanner::scan_mods)) instead of re-walking
+//! the whole tree, which turns repeat integrity checks from O(all files)
+//! into O(changed files).
+
+use camino::{Utf8Path, Utf8PathBuf};
+use notify::{Event, EventKind, RecommendedWatcher, RecursiveMode, Watcher};
+use std::collections::HashSet;
+use std::path::Path;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Arc, Mutex};
+use tracing::warn;
+
+use crate::ScannerError;
+
+/// Everything that changed since the previous drain.
+#[derive(Debug, Default)]
+pub struct WatchDelta {
+    /// Names of top-level `@mod` directories with at least one event.
+    pub dirty_mods: HashSet<String>,
+    /// The watcher can no longer vouch for completeness (event overflow,
+    /// backend error, or a path it could not attribute to a mod). The only
+    /// safe answer is a full re-scan.
+    pub lost_track: bool,
+}
+
+struct WatchState {
+    root: Utf8PathBuf,
+    dirty: Mutex<HashSet<String>>,
+    lost_track: AtomicBool,
+}
+
+impl WatchState {
+    fn record(&self, path: &Path) {
+        let Some(utf) = Utf8Path::from_path(path) else {
+            self.lost_track.store(true, Ordering::Relaxed);
+            return;
+        };
+        let Ok(rel) = utf.strip_prefix(&self.root) else {
+            // Renames can report the far side of a move out of the root;
+            // without knowing where it came from, completeness is gone.
+            self.lost_track.store(true, Ordering::Relaxed);
+            return;
+        };
+        match rel.components().next() {
+            // Scans only ever look inside `@`-prefixed directories, so
+            // events on other top-level entries (fleet.redb, loose files)
+            // cannot change a scan result and are dropped here.
+            Some(top) if top.as_str().starts_with('@') => {
+                self.dirty
+                    .lock()
+                    .unwrap()
+                    .insert(top.as_str().to_string());
+            }
+            _ => {}
+        }
+    }
+}
+
+/// Watches a profile root recursively and accumulates dirty mod names.
+///
+/// The notify backend thread only touches a shared dirty-set; all scanning
+/// happens on the caller's schedule when it drains the watcher.
+pub struct RootWatcher {
+    state: Arc<WatchState>,
+    // Dropping the watcher unsubscribes, so it is held for lifetime only.
+    _watcher: RecommendedWatcher,
+}
+
+impl RootWatcher {
+    pub fn new(root: &Utf8Path) -> Result<Self, ScannerError> {
+        let state = Arc::new(WatchState {
+            root: root.to_path_buf(),
+            dirty: Mutex::new(HashSet::new()),
+            lost_track: AtomicBool::new(false),
+        });
+
+        let handler_state = state.clone();
+        let mut watcher =
+            notify::recommended_watcher(move |res: notify::Result<Event>| match res {
+                Ok(event) => {
+                    if event.need_rescan() {
+                        handler_state.lost_track.store(true, Ordering::Relaxed);
+                        return;
+                    }
+                    // Reads cannot change a scan result, and the incremental
+                    // re-scan itself reads every file it hashes — treating
+                    // access events as dirt would make each re-scan re-dirty
+                    // the mod it just cleaned.
+                    if matches!(event.kind, EventKind::Access(_)) {
+                        return;
+                    }
+                    for path in &event.paths {
+                        handler_state.record(path);
+                    }
+                }
+                Err(e) => {
+                    warn!("Watcher error under {}: {e}", handler_state.root);
+                    handler_state.lost_track.store(true, Ordering::Relaxed);
+                }
+            })
+            .map_err(|e| ScannerError::Watch(e.to_string()))?;
+
+        watcher
+            .watch(root.as_std_path(), RecursiveMode::Recursive)
+            .map_err(|e| ScannerError::Watch(e.to_string()))?;
+
+        Ok(Self {
+            state,
+            _watcher: watcher,
+        })
+    }
+
+    /// Takes everything accumulated since the last drain and resets the
+    /// watcher to a clean slate (including the lost-track flag: the caller
+    /// is expected to answer a lost-track delta with a full scan, after
+    /// which the watcher is authoritative again).
+    pub fn drain(&self) -> WatchDelta {
+        WatchDelta {
+            dirty_mods: std::mem::take(&mut *self.state.dirty.lock().unwrap()),
+            lost_track: self.state.lost_track.swap(false, Ordering::Relaxed),
+        }
+    }
+}
@@ -64,6 +64,8 @@ impl ScanCacheStore for RedbScanCacheStore {
                 mtime: u64,
                 size: u64,
                 checksum: String,
+                #[serde(default)]
+                fast_checksum: String,
             }
             let entry: SerdeEntry = serde_json::from_slice(v.value()).map_err(|e| {
                 fleet_scanner::ScannerError::Cache(format!("decode cache entry: {e}"))
@@ -72,6 +74,7 @@ impl ScanCacheStore for RedbScanCacheStore {
                 mtime: entry.mtime,
                 size: entry.size,
                 checksum: entry.checksum,
+                fast_checksum: entry.fast_checksum,
             };
             cache.entries.insert(rel, entry);
         }
@@ -99,11 +102,13 @@ impl ScanCacheStore for RedbScanCacheStore {
                     mtime: u64,
                     size: u64,
                     checksum: &'a str,
+                    fast_checksum: &'a str,
                 }
                 let value = serde_json::to_vec(&SerdeEntry {
                     mtime: entry.mtime,
                     size: entry.size,
                     checksum: entry.checksum.as_str(),
+                    fast_checksum: entry.fast_checksum.as_str(),
                 })
                 .map_err(|e| {
                     fleet_scanner::ScannerError::Cache(format!("encode cache entry: {e}"))
@@ -214,3 +219,54 @@ fn test_cache_hit_and_miss_behavior() {
         "Should have 1 cache hit (file2)"
     );
 }
+
+#[test]
+fn touched_but_unchanged_file_reuses_cached_checksum() {
+    let temp = tempfile::tempdir().unwrap();
+    let root = Utf8PathBuf::from_path_buf(temp.path().to_path_buf()).unwrap();
+
+    let mod_dir = root.join("@TestMod");
+    fs::create_dir_all(&mod_dir).unwrap();
+    let file1 = mod_dir.join("file1.txt");
+    fs::write(&file1, "Stable content").unwrap();
+
+    let cache_db_path = temp.path().join("scan_cache.redb");
+    let cache_store = Arc::new(RedbScanCacheStore::new(&cache_db_path));
+
+    let manifest1 = Scanner::scan_directory(
+        &root,
+        ScanStrategy::SmartCache,
+        None,
+        Some(cache_store.clone()),
+        None,
+    )
+    .expect("Cold scan failed");
+    let original_checksum = manifest1.mods[0].files[0].checksum.clone();
+
+    // Rewrite identical bytes after a tick: the mtime changes but the fast
+    // digest still matches, so the cached MD5 is reused without a rehash.
+    std::thread::sleep(Duration::from_secs(2));
+    fs::write(&file1, "Stable content").unwrap();
+
+    use std::sync::atomic::{AtomicU64, Ordering};
+    let cached_count = Arc::new(AtomicU64::new(0));
+    let cc = cached_count.clone();
+
+    let manifest2 = Scanner::scan_directory(
+        &root,
+        ScanStrategy::SmartCache,
+        Some(Box::new(move |s| {
+            cc.store(s.files_cached, Ordering::Relaxed);
+        })),
+        Some(cache_store),
+        None,
+    )
+    .expect("Touched scan failed");
+
+    assert_eq!(manifest2.mods[0].files[0].checksum, original_checksum);
+    assert_eq!(
+        cached_count.load(Ordering::Relaxed),
+        1,
+        "Touched-but-unchanged file should hit the fast hash track"
+    );
+}
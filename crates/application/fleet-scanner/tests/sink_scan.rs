@@ -0,0 +1,32 @@
+use camino::Utf8PathBuf;
+use fleet_scanner::{ScanStrategy, Scanner};
+use std::fs;
+use std::sync::Mutex;
+
+#[test]
+fn sink_scan_emits_every_mod_without_retaining_them() {
+    let dir = tempfile::tempdir().unwrap();
+    let root = Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+
+    fs::create_dir_all(root.join("@alpha/addons")).unwrap();
+    fs::write(root.join("@alpha/addons/a.bin"), b"alpha-data").unwrap();
+    fs::create_dir_all(root.join("@beta")).unwrap();
+    fs::write(root.join("@beta/b.bin"), b"beta-data").unwrap();
+
+    let sunk: Mutex<Vec<fleet_core::Mod>> = Mutex::new(Vec::new());
+    Scanner::scan_directory_sink(&root, ScanStrategy::ForceRehash, None, None, None, |m| {
+        sunk.lock().unwrap().push(m.clone());
+    })
+    .unwrap();
+
+    let mut sunk = sunk.into_inner().unwrap();
+    sunk.sort_by(|a, b| a.name.cmp(&b.name));
+
+    // The sink sees exactly what a collecting scan would return.
+    let manifest =
+        Scanner::scan_directory(&root, ScanStrategy::ForceRehash, None, None, None).unwrap();
+    let mut collected = manifest.mods;
+    collected.sort_by(|a, b| a.name.cmp(&b.name));
+    assert_eq!(sunk, collected);
+    assert_eq!(sunk.len(), 2);
+}
@@ -0,0 +1,117 @@
+use camino::{Utf8Path, Utf8PathBuf};
+use fleet_scanner::watch::RootWatcher;
+use fleet_scanner::{ScanStrategy, Scanner};
+use std::fs;
+use std::time::{Duration, Instant};
+
+fn utf8_root(dir: &tempfile::TempDir) -> Utf8PathBuf {
+    Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap()
+}
+
+/// Polls the watcher until `pred` accepts the accumulated dirty set; notify
+/// backends deliver events asynchronously, so tests cannot assert on a
+/// single immediate drain.
+fn wait_for_dirty(
+    watcher: &RootWatcher,
+    pred: impl Fn(&std::collections::HashSet<String>) -> bool,
+) -> std::collections::HashSet<String> {
+    let deadline = Instant::now() + Duration::from_secs(10);
+    let mut seen = std::collections::HashSet::new();
+    loop {
+        let delta = watcher.drain();
+        assert!(!delta.lost_track, "watcher lost track during test");
+        seen.extend(delta.dirty_mods);
+        if pred(&seen) {
+            return seen;
+        }
+        assert!(Instant::now() < deadline, "no event arrived; saw {seen:?}");
+        std::thread::sleep(Duration::from_millis(50));
+    }
+}
+
+#[test]
+fn watcher_attributes_events_to_top_level_mods() {
+    let dir = tempfile::tempdir().unwrap();
+    let root = utf8_root(&dir);
+    fs::create_dir_all(root.join("@alpha/addons")).unwrap();
+    fs::create_dir_all(root.join("@beta")).unwrap();
+
+    let watcher = RootWatcher::new(&root).unwrap();
+
+    fs::write(root.join("@alpha/addons/a.pbo"), b"one").unwrap();
+    // Top-level non-mod entries never affect a scan and must stay invisible.
+    fs::write(root.join("fleet.redb"), b"db").unwrap();
+
+    let seen = wait_for_dirty(&watcher, |s| s.contains("@alpha"));
+    assert!(!seen.contains("fleet.redb"));
+    assert!(!seen.contains("@beta"));
+}
+
+#[test]
+fn drain_resets_the_dirty_set() {
+    let dir = tempfile::tempdir().unwrap();
+    let root = utf8_root(&dir);
+    fs::create_dir_all(root.join("@alpha")).unwrap();
+
+    let watcher = RootWatcher::new(&root).unwrap();
+    fs::write(root.join("@alpha/a.pbo"), b"one").unwrap();
+    wait_for_dirty(&watcher, |s| s.contains("@alpha"));
+
+    // With no further writes the set must settle back to empty.
+    std::thread::sleep(Duration::from_millis(300));
+    let delta = watcher.drain();
+    std::thread::sleep(Duration::from_millis(100));
+    let delta2 = watcher.drain();
+    assert!(delta2.dirty_mods.is_empty(), "{:?} then {:?}", delta.dirty_mods, delta2.dirty_mods);
+}
+
+#[test]
+fn scan_mods_rebuilds_only_the_named_mods() {
+    let dir = tempfile::tempdir().unwrap();
+    let root = utf8_root(&dir);
+    fs::create_dir_all(root.join("@alpha")).unwrap();
+    fs::create_dir_all(root.join("@beta")).unwrap();
+    fs::write(root.join("@alpha/a.txt"), b"alpha v1").unwrap();
+    fs::write(root.join("@beta/b.txt"), b"beta v1").unwrap();
+
+    let full = Scanner::scan_directory(&root, ScanStrategy::SmartCache, None, None, None).unwrap();
+    assert_eq!(full.mods.len(), 2);
+
+    fs::write(root.join("@alpha/a.txt"), b"alpha v2 - now longer").unwrap();
+
+    let rescanned = Scanner::scan_mods(
+        &root,
+        &["@alpha".to_string(), "@gone".to_string()],
+        ScanStrategy::SmartCache,
+        None,
+        None,
+        None,
+    )
+    .unwrap();
+
+    // "@gone" has no directory and silently drops out.
+    assert_eq!(rescanned.len(), 1);
+    let alpha = &rescanned[0];
+    assert_eq!(alpha.name, "@alpha");
+
+    // The rescanned mod matches what a full scan would now produce, and the
+    // untouched mod's entry from the first scan is still valid.
+    let fresh = Scanner::scan_directory(&root, ScanStrategy::SmartCache, None, None, None).unwrap();
+    let fresh_alpha = fresh.mods.iter().find(|m| m.name == "@alpha").unwrap();
+    let old_beta = full.mods.iter().find(|m| m.name == "@beta").unwrap();
+    let fresh_beta = fresh.mods.iter().find(|m| m.name == "@beta").unwrap();
+    assert_eq!(alpha.checksum, fresh_alpha.checksum);
+    assert_ne!(
+        alpha.checksum,
+        full.mods.iter().find(|m| m.name == "@alpha").unwrap().checksum
+    );
+    assert_eq!(old_beta.checksum, fresh_beta.checksum);
+
+    let a = alpha.files.iter().find(|f| f.path == "a.txt").unwrap();
+    let expected = fleet_infra::hashing::scan_file(
+        &root.join("@alpha/a.txt"),
+        Utf8Path::new("a.txt"),
+    )
+    .unwrap();
+    assert_eq!(a.checksum, expected.checksum);
+}
@@ -0,0 +1,121 @@
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use fleet_core::diff::diff;
+use fleet_core::{File, FilePart, FileType, Manifest, Mod};
+use std::hint::black_box;
+
+const RAW_CHUNK_SIZE: u64 = 5_000_000;
+
+/// Tiny deterministic xorshift so generated manifests are reproducible
+/// across runs without pulling a rand dependency into the workspace.
+struct Rng(u64);
+
+impl Rng {
+    fn next(&mut self) -> u64 {
+        self.0 ^= self.0 << 13;
+        self.0 ^= self.0 >> 7;
+        self.0 ^= self.0 << 17;
+        self.0
+    }
+}
+
+fn synth_file(rng: &mut Rng, mod_idx: usize, file_idx: usize) -> File {
+    let length = 1_000_000 + rng.next() % 20_000_000;
+    let mut parts = Vec::new();
+    let mut start = 0u64;
+    while start < length {
+        let part_len = (length - start).min(RAW_CHUNK_SIZE);
+        parts.push(FilePart {
+            path: format!("file_{}.pbo_{}", file_idx, start + part_len),
+            length: part_len,
+            start,
+            checksum: format!("{:032X}", rng.next()),
+        });
+        start += part_len;
+    }
+    File {
+        path: format!("addons/mod{}_file_{}.pbo", mod_idx, file_idx),
+        length,
+        checksum: format!("{:032X}", rng.next()),
+        file_type: FileType::Pbo,
+        parts,
+        canonical: Default::default(),
+    }
+}
+
+/// Generates a manifest with `mods * files_per_mod` files, deterministic for
+/// a given seed so remote/local pairs share content.
+fn synth_manifest(mods: usize, files_per_mod: usize, seed: u64) -> Manifest {
+    let mut rng = Rng(seed | 1);
+    let mods = (0..mods)
+        .map(|m| {
+            let files: Vec<File> = (0..files_per_mod)
+                .map(|f| synth_file(&mut rng, m, f))
+                .collect();
+            Mod {
+                name: format!("@synthetic_mod_{}", m),
+                checksum: format!("{:032X}", rng.next()),
+                files,
+            }
+        })
+        .collect();
+    Manifest {
+        version: "1.0".to_string(),
+        mods,
+    }
+}
+
+/// Local copy of `remote` with roughly one file in `dirty_ratio` modified,
+/// mimicking a typical incremental update rather than a clean or fully
+/// divergent tree.
+fn perturb(remote: &Manifest, dirty_ratio: usize) -> Manifest {
+    let mut local = remote.clone();
+    let mut rng = Rng(0xD1FF);
+    for m in &mut local.mods {
+        for f in &mut m.files {
+            if rng.next() as usize % dirty_ratio == 0 {
+                f.checksum = format!("{:032X}", rng.next());
+            }
+        }
+    }
+    local
+}
+
+fn bench_diff(c: &mut Criterion) {
+    let mut group = c.benchmark_group("diff");
+    group.sample_size(10);
+
+    for &total_files in &[10_000usize, 100_000, 500_000] {
+        let mods = total_files / 1_000;
+        let remote = synth_manifest(mods, 1_000, 42);
+        let local = perturb(&remote, 50);
+
+        group.throughput(Throughput::Elements(total_files as u64));
+        group.bench_with_input(
+            BenchmarkId::new("dirty_2pct", total_files),
+            &(&remote, &local),
+            |b, (remote, local)| b.iter(|| black_box(diff(remote, local))),
+        );
+        group.bench_with_input(
+            BenchmarkId::new("clean", total_files),
+            &(&remote, &remote.clone()),
+            |b, (remote, local)| b.iter(|| black_box(diff(remote, local))),
+        );
+    }
+    group.finish();
+}
+
+fn bench_plan_file_delta(c: &mut Criterion) {
+    let mut rng = Rng(7);
+    let remote = synth_file(&mut rng, 0, 0);
+    let mut local = remote.clone();
+    // Invalidate one middle part so the planner both reuses and fetches.
+    let mid = local.parts.len() / 2;
+    local.parts[mid].checksum = format!("{:032X}", rng.next());
+
+    c.bench_function("plan_file_delta", |b| {
+        b.iter(|| black_box(fleet_core::diff::plan_file_delta(&remote, &local)))
+    });
+}
+
+criterion_group!(benches, bench_diff, bench_plan_file_delta);
+criterion_main!(benches);
@@ -1,6 +1,6 @@
-use crate::path_utils::FleetPath;
 use crate::{
-    DeleteAction, DownloadAction, File, Manifest, Mod, RenameAction, SyncPlan, VerificationAction,
+    DeleteAction, DeltaSegment, DownloadAction, File, FileDelta, Manifest, Mod, RenameAction,
+    SyncPlan, VerificationAction,
 };
 use std::collections::{HashMap, HashSet};
 
@@ -63,6 +63,7 @@ pub fn diff(remote: &Manifest, local: &Manifest) -> SyncPlan {
                     rel_path: file.path.clone(),
                     size: file.length,
                     expected_checksum: file.checksum.clone(),
+                    delta: None,
                 });
             }
         }
@@ -92,20 +93,21 @@ fn diff_files(
     deletes: &mut Vec<DeleteAction>,
     checks: &mut Vec<VerificationAction>,
 ) {
-    // Map Local Files: normalized_path -> File
-    let local_files: HashMap<String, &File> = local_mod
+    // Map Local Files: canonical_path -> File. The canonical keys are cached
+    // on each `File`, so diffing a mod allocates no per-comparison strings.
+    let local_files: HashMap<&str, &File> = local_mod
         .files
         .iter()
-        .map(|f| (FleetPath::canonicalize(&f.path), f))
+        .map(|f| (f.canonical_path(), f))
         .collect();
 
-    let mut visited_files = HashSet::new();
+    let mut visited_files: HashSet<&str> = HashSet::new();
 
     for remote_file in &remote_mod.files {
-        let key = FleetPath::canonicalize(&remote_file.path);
-        visited_files.insert(key.clone());
+        let key = remote_file.canonical_path();
+        visited_files.insert(key);
 
-        match local_files.get(&key) {
+        match local_files.get(key) {
             Some(local_file) => {
                 if local_file.checksum != remote_file.checksum {
                     downloads.push(DownloadAction {
@@ -113,6 +115,7 @@ fn diff_files(
                         rel_path: remote_file.path.clone(),
                         size: remote_file.length,
                         expected_checksum: remote_file.checksum.clone(),
+                        delta: plan_file_delta(remote_file, local_file),
                     });
                 } else {
                     checks.push(VerificationAction {
@@ -127,6 +130,7 @@ fn diff_files(
                     rel_path: remote_file.path.clone(),
                     size: remote_file.length,
                     expected_checksum: remote_file.checksum.clone(),
+                    delta: None,
                 });
             }
         }
@@ -134,8 +138,7 @@ fn diff_files(
 
     // Identify local files that don't exist in remote (Deletes)
     for local_file in &local_mod.files {
-        let key = FleetPath::canonicalize(&local_file.path);
-        if !visited_files.contains(&key) {
+        if !visited_files.contains(local_file.canonical_path()) {
             deletes.push(DeleteAction {
                 // Delete path includes mod name to be absolute relative to root
                 path: format!("{}/{}", local_mod.name, local_file.path),
@@ -143,3 +146,72 @@ fn diff_files(
         }
     }
 }
+
+/// Build a part-level reconstruction plan for a changed file.
+///
+/// Parts are matched by content (checksum + length) rather than by name or
+/// offset, so data that merely shifted inside a PBO is still reused. Returns
+/// `None` when either side lacks part data, the remote part table does not
+/// tile the file, or nothing is reusable - callers then fall back to a
+/// full-file download.
+pub fn plan_file_delta(remote: &File, local: &File) -> Option<FileDelta> {
+    if remote.parts.is_empty() || local.parts.is_empty() {
+        return None;
+    }
+
+    let mut local_by_content: HashMap<(&str, u64), u64> = HashMap::new();
+    for part in &local.parts {
+        local_by_content
+            .entry((part.checksum.as_str(), part.length))
+            .or_insert(part.start);
+    }
+
+    let mut segments: Vec<DeltaSegment> = Vec::new();
+    let mut reused_bytes: u64 = 0;
+    let mut expected_offset: u64 = 0;
+
+    for part in &remote.parts {
+        // A malformed part table (gaps or overlaps) cannot be spliced safely.
+        if part.start != expected_offset {
+            return None;
+        }
+        expected_offset += part.length;
+
+        if part.length == 0 {
+            continue;
+        }
+
+        match local_by_content.get(&(part.checksum.as_str(), part.length)) {
+            Some(&local_start) => {
+                reused_bytes += part.length;
+                segments.push(DeltaSegment::CopyLocal {
+                    local_start,
+                    length: part.length,
+                });
+            }
+            None => {
+                // Coalesce adjacent misses into a single Range request.
+                if let Some(DeltaSegment::Fetch {
+                    remote_start,
+                    length,
+                }) = segments.last_mut()
+                {
+                    if *remote_start + *length == part.start {
+                        *length += part.length;
+                        continue;
+                    }
+                }
+                segments.push(DeltaSegment::Fetch {
+                    remote_start: part.start,
+                    length: part.length,
+                });
+            }
+        }
+    }
+
+    if expected_offset != remote.length || reused_bytes == 0 {
+        return None;
+    }
+
+    Some(FileDelta { segments })
+}
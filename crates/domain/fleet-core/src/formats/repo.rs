@@ -10,6 +10,9 @@ pub struct RepositoryExternal {
     pub checksum: String,
     pub required_mods: Vec<RepoModExternal>,
     pub optional_mods: Vec<RepoModExternal>,
+    /// Alternate base URLs hosting the same repo content.
+    #[serde(default)]
+    pub mirrors: Vec<String>,
 }
 
 #[derive(Debug, Deserialize, Serialize, Clone)]
@@ -41,6 +44,7 @@ impl From<RepositoryExternal> for Repository {
             required_mods: r.required_mods.into_iter().map(|m| m.into()).collect(),
             optional_mods: r.optional_mods.into_iter().map(|m| m.into()).collect(),
             servers: Vec::new(),
+            mirrors: r.mirrors,
         }
     }
 }
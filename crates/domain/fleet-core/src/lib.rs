@@ -40,6 +40,47 @@ pub struct File {
     #[serde(rename = "Type")]
     pub file_type: FileType,
     pub parts: Vec<FilePart>,
+    /// Cached canonical form of `path`; read it through
+    /// [`File::canonical_path`]. Not part of the wire format.
+    #[serde(skip)]
+    pub canonical: CanonicalKey,
+}
+
+impl File {
+    /// Canonical (normalized, lowercased) path used for diffing and sorting.
+    /// Computed at most once per `File` instead of per comparison.
+    pub fn canonical_path(&self) -> &str {
+        self.canonical
+            .0
+            .get_or_init(|| path_utils::FleetPath::canonicalize(&self.path))
+    }
+}
+
+/// Lazily computed canonical path cache. Transparent to equality and serde so
+/// `File` values compare and serialize exactly as before.
+#[derive(Default)]
+pub struct CanonicalKey(std::sync::OnceLock<String>);
+
+impl Clone for CanonicalKey {
+    fn clone(&self) -> Self {
+        let cell = std::sync::OnceLock::new();
+        if let Some(v) = self.0.get() {
+            let _ = cell.set(v.clone());
+        }
+        Self(cell)
+    }
+}
+
+impl PartialEq for CanonicalKey {
+    fn eq(&self, _other: &Self) -> bool {
+        true
+    }
+}
+
+impl std::fmt::Debug for CanonicalKey {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_tuple("CanonicalKey").field(&self.0.get()).finish()
+    }
 }
 
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
@@ -71,6 +112,39 @@ pub struct DownloadAction {
     pub rel_path: String,
     pub size: u64,
     pub expected_checksum: String,
+    /// Part-level reconstruction plan. When present, the download layer can
+    /// rebuild the file from the existing local copy plus HTTP Range fetches
+    /// instead of transferring the whole file.
+    pub delta: Option<FileDelta>,
+}
+
+/// Byte-exact plan to rebuild a changed file from reusable local parts and
+/// fetched remote byte ranges. Segments are ordered by output offset and
+/// tile the remote file completely.
+#[derive(Debug, Clone, PartialEq)]
+pub struct FileDelta {
+    pub segments: Vec<DeltaSegment>,
+}
+
+#[derive(Debug, Clone, PartialEq)]
+pub enum DeltaSegment {
+    /// Copy `length` bytes starting at `local_start` in the existing local file.
+    CopyLocal { local_start: u64, length: u64 },
+    /// Fetch bytes `[remote_start, remote_start + length)` with an HTTP Range request.
+    Fetch { remote_start: u64, length: u64 },
+}
+
+impl FileDelta {
+    /// Bytes that still have to cross the network.
+    pub fn fetch_bytes(&self) -> u64 {
+        self.segments
+            .iter()
+            .map(|s| match s {
+                DeltaSegment::Fetch { length, .. } => *length,
+                DeltaSegment::CopyLocal { .. } => 0,
+            })
+            .sum()
+    }
 }
 
 #[derive(Debug, Clone)]
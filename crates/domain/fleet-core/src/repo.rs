@@ -14,6 +14,10 @@ pub struct Repository {
     pub optional_mods: Vec<RepoMod>,
     #[serde(default)]
     pub servers: Vec<Server>,
+    /// Alternate base URLs hosting the same repo content. Downloads are
+    /// spread across these in addition to the primary URL.
+    #[serde(default)]
+    pub mirrors: Vec<String>,
 }
 
 #[derive(Debug, Deserialize, Serialize, Clone)]
@@ -0,0 +1,157 @@
+use fleet_core::diff::plan_file_delta;
+use fleet_core::{DeltaSegment, File, FilePart, FileType};
+
+// --- Helper Functions ---
+
+fn make_part(path: &str, start: u64, length: u64, checksum: &str) -> FilePart {
+    FilePart {
+        path: path.to_string(),
+        start,
+        length,
+        checksum: checksum.to_string(),
+    }
+}
+
+fn make_file(checksum: &str, parts: Vec<FilePart>) -> File {
+    let length = parts.iter().map(|p| p.length).sum();
+    File {
+        path: "addons/pack.pbo".to_string(),
+        length,
+        checksum: checksum.to_string(),
+        file_type: FileType::Pbo,
+        parts,
+        canonical: Default::default(),
+    }
+}
+
+// --- Tests ---
+
+#[test]
+fn single_changed_part_fetches_only_that_range() {
+    let local = make_file(
+        "OLD",
+        vec![
+            make_part("a", 0, 100, "AAA"),
+            make_part("b", 100, 50, "BBB"),
+            make_part("c", 150, 200, "CCC"),
+        ],
+    );
+    let remote = make_file(
+        "NEW",
+        vec![
+            make_part("a", 0, 100, "AAA"),
+            make_part("b", 100, 50, "B22"),
+            make_part("c", 150, 200, "CCC"),
+        ],
+    );
+
+    let delta = plan_file_delta(&remote, &local).expect("delta expected");
+    assert_eq!(
+        delta.segments,
+        vec![
+            DeltaSegment::CopyLocal {
+                local_start: 0,
+                length: 100
+            },
+            DeltaSegment::Fetch {
+                remote_start: 100,
+                length: 50
+            },
+            DeltaSegment::CopyLocal {
+                local_start: 150,
+                length: 200
+            },
+        ]
+    );
+    assert_eq!(delta.fetch_bytes(), 50);
+}
+
+#[test]
+fn shifted_part_is_reused_from_old_offset() {
+    // A new entry inserted at the front shifts "a" and "b"; their content
+    // should still be copied from the old offsets.
+    let local = make_file(
+        "OLD",
+        vec![make_part("a", 0, 100, "AAA"), make_part("b", 100, 50, "BBB")],
+    );
+    let remote = make_file(
+        "NEW",
+        vec![
+            make_part("new", 0, 30, "NNN"),
+            make_part("a", 30, 100, "AAA"),
+            make_part("b", 130, 50, "BBB"),
+        ],
+    );
+
+    let delta = plan_file_delta(&remote, &local).expect("delta expected");
+    assert_eq!(
+        delta.segments,
+        vec![
+            DeltaSegment::Fetch {
+                remote_start: 0,
+                length: 30
+            },
+            DeltaSegment::CopyLocal {
+                local_start: 0,
+                length: 100
+            },
+            DeltaSegment::CopyLocal {
+                local_start: 100,
+                length: 50
+            },
+        ]
+    );
+}
+
+#[test]
+fn adjacent_missing_parts_coalesce_into_one_fetch() {
+    let local = make_file("OLD", vec![make_part("a", 0, 100, "AAA")]);
+    let remote = make_file(
+        "NEW",
+        vec![
+            make_part("a", 0, 100, "AAA"),
+            make_part("b", 100, 50, "B22"),
+            make_part("c", 150, 60, "C22"),
+        ],
+    );
+
+    let delta = plan_file_delta(&remote, &local).expect("delta expected");
+    assert_eq!(
+        delta.segments,
+        vec![
+            DeltaSegment::CopyLocal {
+                local_start: 0,
+                length: 100
+            },
+            DeltaSegment::Fetch {
+                remote_start: 100,
+                length: 110
+            },
+        ]
+    );
+}
+
+#[test]
+fn no_delta_without_parts_or_reusable_data() {
+    let with_parts = make_file("X", vec![make_part("a", 0, 100, "AAA")]);
+    let no_parts = make_file("Y", vec![]);
+    assert!(plan_file_delta(&with_parts, &no_parts).is_none());
+    assert!(plan_file_delta(&no_parts, &with_parts).is_none());
+
+    // Nothing in common: a full download is simpler than a delta.
+    let local = make_file("OLD", vec![make_part("a", 0, 100, "AAA")]);
+    let remote = make_file("NEW", vec![make_part("a", 0, 100, "ZZZ")]);
+    assert!(plan_file_delta(&remote, &local).is_none());
+}
+
+#[test]
+fn no_delta_for_malformed_part_table() {
+    let local = make_file("OLD", vec![make_part("a", 0, 100, "AAA")]);
+    // Gap between parts: the table does not tile the file.
+    let mut remote = make_file(
+        "NEW",
+        vec![make_part("a", 0, 100, "AAA"), make_part("b", 150, 50, "BBB")],
+    );
+    remote.length = 200;
+    assert!(plan_file_delta(&remote, &local).is_none());
+}
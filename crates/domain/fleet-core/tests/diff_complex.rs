@@ -10,6 +10,7 @@ fn make_file(path: &str, checksum: &str) -> File {
         checksum: checksum.to_string(),
         file_type: FileType::File,
         parts: vec![],
+        canonical: Default::default(),
     }
 }
 
@@ -0,0 +1,103 @@
+use camino::{Utf8Path, Utf8PathBuf};
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use fleet_infra::hashing::{fast_file_digest, scan_file};
+use std::hint::black_box;
+
+/// Builds valid PBO bytes the same way the streaming-hash tests do; the
+/// parser in `hashing` is the ground truth for what counts as well-formed.
+fn build_pbo(entries: &[(&str, Vec<u8>)], trailing: &[u8]) -> Vec<u8> {
+    let mut out = Vec::new();
+    for (name, data) in entries {
+        out.extend_from_slice(name.as_bytes());
+        out.push(0);
+        out.extend_from_slice(&0u32.to_le_bytes()); // type
+        out.extend_from_slice(&(data.len() as u32).to_le_bytes()); // original_size
+        out.extend_from_slice(&0u32.to_le_bytes()); // offset
+        out.extend_from_slice(&0u32.to_le_bytes()); // timestamp
+        out.extend_from_slice(&(data.len() as u32).to_le_bytes()); // data_size
+    }
+    out.push(0);
+    out.extend_from_slice(&[0u8; 20]);
+    for (_, data) in entries {
+        out.extend_from_slice(data);
+    }
+    out.extend_from_slice(trailing);
+    out
+}
+
+fn patterned(len: usize, seed: u8) -> Vec<u8> {
+    (0..len).map(|i| (i as u8).wrapping_mul(31).wrapping_add(seed)).collect()
+}
+
+fn write_temp(dir: &tempfile::TempDir, name: &str, bytes: &[u8]) -> Utf8PathBuf {
+    let path = dir.path().join(name);
+    std::fs::write(&path, bytes).unwrap();
+    Utf8PathBuf::from_path_buf(path).unwrap()
+}
+
+fn bench_scan_raw(c: &mut Criterion) {
+    let dir = tempfile::tempdir().unwrap();
+    let mut group = c.benchmark_group("scan_file/raw");
+    group.sample_size(10);
+
+    // 64 KB: syscall/setup dominated. 16 MB: one part boundary crossed.
+    // 80 MB: past PARALLEL_HASH_MIN_LEN, part hashing fans out on rayon.
+    for &len in &[64 * 1024usize, 16_000_000, 80_000_000] {
+        let path = write_temp(&dir, &format!("raw_{len}.bin"), &patterned(len, 3));
+        group.throughput(Throughput::Bytes(len as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(len), &path, |b, path| {
+            b.iter(|| black_box(scan_file(path, Utf8Path::new("terrain.wrp")).unwrap()))
+        });
+    }
+    group.finish();
+}
+
+fn bench_scan_pbo(c: &mut Criterion) {
+    let dir = tempfile::tempdir().unwrap();
+    let mut group = c.benchmark_group("scan_file/pbo");
+    group.sample_size(10);
+
+    // Entry count stresses header parsing; entry size stresses the hash
+    // kernel. 1000 x 64 KB is a typical addon, 20 x 4 MB a texture pack.
+    for &(entries, entry_len) in &[(1000usize, 64 * 1024usize), (20, 4_000_000)] {
+        let owned: Vec<(String, Vec<u8>)> = (0..entries)
+            .map(|i| (format!("data\\entry_{i}.paa"), patterned(entry_len, i as u8)))
+            .collect();
+        let borrowed: Vec<(&str, Vec<u8>)> = owned
+            .iter()
+            .map(|(n, d)| (n.as_str(), d.clone()))
+            .collect();
+        let bytes = build_pbo(&borrowed, b"trailing-signature");
+        let path = write_temp(&dir, &format!("bench_{entries}.pbo"), &bytes);
+
+        // Corpus sanity check: the scanner must see a parseable PBO, not
+        // fall back to raw-chunk hashing.
+        let scanned = scan_file(&path, Utf8Path::new("addons/bench.pbo")).unwrap();
+        assert_eq!(scanned.file_type, fleet_core::FileType::Pbo);
+        assert_eq!(scanned.parts.len(), entries + 2); // header + entries + $$END$$
+
+        group.throughput(Throughput::Bytes(bytes.len() as u64));
+        group.bench_with_input(
+            BenchmarkId::new("entries", entries),
+            &path,
+            |b, path| b.iter(|| black_box(scan_file(path, Utf8Path::new("addons/bench.pbo")).unwrap())),
+        );
+    }
+    group.finish();
+}
+
+fn bench_fast_digest(c: &mut Criterion) {
+    let dir = tempfile::tempdir().unwrap();
+    let len = 16_000_000usize;
+    let path = write_temp(&dir, "fast.bin", &patterned(len, 9));
+
+    let mut group = c.benchmark_group("fast_file_digest");
+    group.throughput(Throughput::Bytes(len as u64));
+    group.bench_function("16MB", |b| {
+        b.iter(|| black_box(fast_file_digest(&path).unwrap()))
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_scan_raw, bench_scan_pbo, bench_fast_digest);
+criterion_main!(benches);
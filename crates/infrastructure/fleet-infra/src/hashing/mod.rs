@@ -1,13 +1,22 @@
-use byteorder::{LittleEndian, ReadBytesExt};
 use camino::Utf8Path;
 use fleet_core::{FilePart, FileType};
 use md5::Context;
-use std::collections::HashMap;
+use std::borrow::Cow;
 use std::fs::File;
 use std::io::{BufRead, BufReader, Read, Seek, SeekFrom};
 
 const MAX_PBO_STRING_LEN: usize = 1024;
 
+// Nimble uses 5,000,000 byte chunks for raw file parts
+const RAW_CHUNK_SIZE: u64 = 5_000_000;
+
+/// Files at least this large hash their parts across the rayon pool.
+const PARALLEL_HASH_MIN_LEN: u64 = 64 * 1024 * 1024;
+
+/// Upper bound for buffering a PBO header during streaming verification.
+/// Real headers are well under a megabyte even for 20k-entry PBOs.
+const MAX_STREAM_HEADER_LEN: usize = 16 * 1024 * 1024;
+
 #[derive(Debug, thiserror::Error)]
 pub enum ScanError {
     #[error("IO error: {0}")]
@@ -18,6 +27,45 @@ pub enum ScanError {
     Utf8,
 }
 
+/// Version prefix baked into every fast digest. Bumping it makes all stored
+/// digests mismatch, which transparently falls verification back to a full
+/// MD5 rehash - no schema migration needed when the algorithm changes.
+pub const FAST_HASH_VERSION: u32 = 1;
+
+/// Fast non-cryptographic digest (xxh3-128) for local verification paths.
+///
+/// Swifty compatibility only requires MD5 for data exchanged with the
+/// server; purely local integrity checks can use this track instead, which
+/// runs at disk speed. The result is prefixed with [`FAST_HASH_VERSION`] so
+/// digests from a different algorithm version never compare equal.
+pub fn fast_file_digest(fs_path: &Utf8Path) -> Result<String, ScanError> {
+    use xxhash_rust::xxh3::Xxh3;
+
+    let file = File::open(fs_path)?;
+    let len = file.metadata()?.len();
+
+    let digest = if len == 0 {
+        xxhash_rust::xxh3::xxh3_128(&[])
+    } else if let Ok(map) = unsafe { memmap2::Mmap::map(&file) } {
+        xxhash_rust::xxh3::xxh3_128(&map)
+    } else {
+        let mut hasher = Xxh3::new();
+        let mut reader = BufReader::with_capacity(1024 * 1024, file);
+        loop {
+            let chunk = reader.fill_buf()?;
+            if chunk.is_empty() {
+                break;
+            }
+            hasher.update(chunk);
+            let consumed = chunk.len();
+            reader.consume(consumed);
+        }
+        hasher.digest128()
+    };
+
+    Ok(format!("{FAST_HASH_VERSION}:{digest:032X}"))
+}
+
 /// Compute the checksum string for a file using Swifty/Nimble logic.
 pub fn compute_file_checksum(
     fs_path: &Utf8Path,
@@ -33,14 +81,151 @@ pub fn scan_file(
     logical_path: &Utf8Path,
 ) -> Result<fleet_core::File, ScanError> {
     let extension = logical_path.extension().unwrap_or("").to_lowercase();
+    let is_pbo = extension == "pbo";
+
+    // Fast path: map the whole file so the MD5 kernel runs over large
+    // contiguous slices instead of 8 KB read() calls, which is syscall-bound
+    // on fast disks. Files that cannot be mapped fall back to the buffered
+    // readers below.
+    let file = File::open(fs_path)?;
+    let len = file.metadata()?.len();
+    if len == 0 {
+        return if is_pbo {
+            scan_pbo_slice(&[], logical_path)
+        } else {
+            Ok(scan_raw_slice(&[], logical_path))
+        };
+    }
+    // SAFETY: the mapping is read-only and private to this call. Truncating a
+    // file while it is being scanned was already racy with the reader path.
+    if let Ok(map) = unsafe { memmap2::Mmap::map(&file) } {
+        return if is_pbo {
+            scan_pbo_slice(&map, logical_path)
+        } else {
+            Ok(scan_raw_slice(&map, logical_path))
+        };
+    }
+    drop(file);
 
-    if extension == "pbo" {
+    if is_pbo {
         scan_pbo(fs_path, logical_path)
     } else {
         scan_raw_file(fs_path, logical_path)
     }
 }
 
+// --- In-memory (mmap) logic ---
+
+fn scan_raw_slice(data: &[u8], logical_path: &Utf8Path) -> fleet_core::File {
+    use rayon::prelude::*;
+
+    let file_name = logical_path.file_name().unwrap_or("unknown");
+
+    // Each 5,000,000-byte part covers an independent range, so a single
+    // multi-gigabyte file can fan its part hashing out across the rayon pool
+    // instead of pinning one core at the tail of a scan. Small files stay
+    // sequential; the fork/join overhead outruns the hashing below this size.
+    let checksums: Vec<String> = if data.len() as u64 >= PARALLEL_HASH_MIN_LEN {
+        data.par_chunks(RAW_CHUNK_SIZE as usize)
+            .map(|chunk| format!("{:X}", md5::compute(chunk)))
+            .collect()
+    } else {
+        data.chunks(RAW_CHUNK_SIZE as usize)
+            .map(|chunk| format!("{:X}", md5::compute(chunk)))
+            .collect()
+    };
+
+    let mut parts = Vec::with_capacity(checksums.len());
+    let mut pos: u64 = 0;
+    for (chunk, checksum) in data.chunks(RAW_CHUNK_SIZE as usize).zip(checksums) {
+        let start = pos;
+        pos += chunk.len() as u64;
+        parts.push(FilePart {
+            path: format!("{}_{}", file_name, pos),
+            length: chunk.len() as u64,
+            start,
+            checksum,
+        });
+    }
+
+    let mut hasher = Context::new();
+    for part in &parts {
+        hasher.consume(part.checksum.as_bytes());
+    }
+
+    fleet_core::File {
+        path: logical_path.as_str().replace('\\', "/"),
+        length: data.len() as u64,
+        checksum: format!("{:X}", hasher.finalize()),
+        file_type: FileType::File,
+        parts,
+        canonical: Default::default(),
+    }
+}
+
+fn scan_pbo_slice(data: &[u8], logical_path: &Utf8Path) -> Result<fleet_core::File, ScanError> {
+    use rayon::prelude::*;
+
+    let (header_len, entries) = parse_pbo_header(data)?;
+
+    let total_len = data.len() as u64;
+    // An entry's claimed data_size may run past EOF; hash only what exists,
+    // exactly like the reader path's `take()` does.
+    let clamped = |start: u64, len: u64| -> &[u8] {
+        let start = start.min(total_len) as usize;
+        let end = (start as u64 + len).min(total_len) as usize;
+        &data[start..end]
+    };
+
+    // Lay out every part as (path, start, length) first so large PBOs can
+    // spread the hashing itself across the rayon pool.
+    let mut layout = Vec::with_capacity(entries.len() + 2);
+    layout.push(("$$HEADER$$".to_string(), 0u64, header_len));
+    let mut current_offset = header_len;
+    for entry in entries {
+        let size = entry.data_size as u64;
+        layout.push((entry.filename.into_owned(), current_offset, size));
+        current_offset += size;
+    }
+    let remaining = total_len.saturating_sub(current_offset);
+    if remaining > 0 {
+        layout.push(("$$END$$".to_string(), current_offset, remaining));
+    }
+
+    let hash_part =
+        |&(_, start, len): &(String, u64, u64)| format!("{:X}", md5::compute(clamped(start, len)));
+    let checksums: Vec<String> = if total_len >= PARALLEL_HASH_MIN_LEN {
+        layout.par_iter().map(hash_part).collect()
+    } else {
+        layout.iter().map(hash_part).collect()
+    };
+
+    let parts: Vec<FilePart> = layout
+        .into_iter()
+        .zip(checksums)
+        .map(|((path, start, length), checksum)| FilePart {
+            path,
+            length,
+            start,
+            checksum,
+        })
+        .collect();
+
+    let mut hasher = Context::new();
+    for part in &parts {
+        hasher.consume(part.checksum.as_bytes());
+    }
+
+    Ok(fleet_core::File {
+        path: logical_path.as_str().replace('\\', "/"),
+        length: total_len,
+        checksum: format!("{:X}", hasher.finalize()),
+        file_type: FileType::Pbo,
+        parts,
+        canonical: Default::default(),
+    })
+}
+
 // --- Raw File Logic ---
 
 fn scan_raw_file(
@@ -53,9 +238,6 @@ fn scan_raw_file(
     let mut parts = Vec::new();
     let mut pos: u64 = 0;
 
-    // Nimble uses 5,000,000 byte chunks
-    const CHUNK_SIZE: u64 = 5_000_000;
-
     // We can't easily predict file size if we just read stream,
     // but for the final struct we need total length.
     let total_len = fs_path.metadata()?.len();
@@ -63,7 +245,7 @@ fn scan_raw_file(
     // Loop until EOF, hashing CHUNK_SIZE blocks into MD5 parts
     loop {
         let mut hasher = Context::new();
-        let mut stream = reader.by_ref().take(CHUNK_SIZE);
+        let mut stream = reader.by_ref().take(RAW_CHUNK_SIZE);
 
         let pre_copy_pos = pos;
         let mut buf = [0u8; 8192];
@@ -107,35 +289,75 @@ fn scan_raw_file(
         checksum: format!("{:X}", hasher.finalize()),
         file_type: FileType::File,
         parts,
+        canonical: Default::default(),
     })
 }
 
 // --- PBO Logic ---
 
-struct PboEntry {
-    filename: String,
+/// One data entry from the PBO header. The filename borrows from the header
+/// buffer and is only turned into an owned `String` once it becomes a
+/// `FilePart` path.
+struct PboEntry<'a> {
+    filename: Cow<'a, str>,
     data_size: u32,
-    r#type: u32,
-    // We don't actually need original_size, offset, timestamp for hashing
-    // but we read them to advance the cursor correctly.
 }
 
-/// Reads the PBO header to determine header length and entry list.
-/// This mimics `nimble/src/pbo.rs` logic exactly.
-fn parse_pbo_metadata<R: BufRead + Seek>(input: &mut R) -> Result<(u64, Vec<PboEntry>), ScanError> {
+/// Cursor over a borrowed header buffer. Both accessors fail when the buffer
+/// runs out, which callers treat the same as a corrupt header (streaming
+/// callers keep buffering and retry).
+struct HeaderWalker<'a> {
+    data: &'a [u8],
+    pos: usize,
+}
+
+impl<'a> HeaderWalker<'a> {
+    /// Null-terminated byte string, without the terminator.
+    fn cstr(&mut self) -> Result<&'a [u8], ScanError> {
+        let limit = self.data.len().min(self.pos + MAX_PBO_STRING_LEN);
+        let len = self.data[self.pos..limit]
+            .iter()
+            .position(|&b| b == 0)
+            .ok_or(ScanError::PboParse)?;
+        let s = &self.data[self.pos..self.pos + len];
+        self.pos += len + 1;
+        Ok(s)
+    }
+
+    fn u32(&mut self) -> Result<u32, ScanError> {
+        let bytes: [u8; 4] = self
+            .data
+            .get(self.pos..self.pos + 4)
+            .and_then(|s| s.try_into().ok())
+            .ok_or(ScanError::PboParse)?;
+        self.pos += 4;
+        Ok(u32::from_le_bytes(bytes))
+    }
+}
+
+/// Walks the PBO entry table over a borrowed buffer to determine the header
+/// length and entry list. This mimics `nimble/src/pbo.rs` logic exactly, but
+/// as a single in-memory pass: no per-field reads, and entry filenames stay
+/// borrowed slices of the buffer.
+fn parse_pbo_header(data: &[u8]) -> Result<(u64, Vec<PboEntry<'_>>), ScanError> {
+    let mut w = HeaderWalker { data, pos: 0 };
     let mut entries = Vec::new();
 
     loop {
-        let filename = read_null_terminated_string(input)?;
+        let filename = w.cstr()?;
 
-        let type_id = input.read_u32::<LittleEndian>()?;
-        let _original_size = input.read_u32::<LittleEndian>()?;
-        let _offset = input.read_u32::<LittleEndian>()?;
-        let _timestamp = input.read_u32::<LittleEndian>()?;
-        let data_size = input.read_u32::<LittleEndian>()?;
+        let type_id = w.u32()?;
+        let _original_size = w.u32()?;
+        let _offset = w.u32()?;
+        let _timestamp = w.u32()?;
+        let data_size = w.u32()?;
 
         if type_id == 0x56657273 {
-            read_extensions(input)?;
+            // Version entry: skip the extension key/value strings without
+            // materializing them.
+            while !w.cstr()?.is_empty() {
+                w.cstr()?;
+            }
             continue;
         }
 
@@ -144,53 +366,55 @@ fn parse_pbo_metadata<R: BufRead + Seek>(input: &mut R) -> Result<(u64, Vec<PboE
         }
 
         entries.push(PboEntry {
-            filename,
+            filename: String::from_utf8_lossy(filename),
             data_size,
-            r#type: type_id,
         });
     }
 
-    let header_len = input.stream_position()?;
-    Ok((header_len, entries))
+    Ok((w.pos as u64, entries))
 }
 
-fn read_extensions<R: BufRead>(input: &mut R) -> Result<HashMap<String, String>, ScanError> {
-    let mut map = HashMap::new();
+/// Slurps the header region from the start of a PBO in a few geometrically
+/// growing reads, so cold-cache header parsing costs a handful of syscalls
+/// instead of one per field. The returned buffer may extend past the header;
+/// callers re-seek before hashing.
+fn read_header_region<R: Read>(reader: &mut R) -> Result<Vec<u8>, ScanError> {
+    let mut buf = Vec::new();
+    let mut chunk = 64 * 1024usize;
     loop {
-        let key = read_null_terminated_string(input)?;
-        if key.is_empty() {
-            break;
+        let start = buf.len();
+        buf.resize(start + chunk, 0);
+        let mut filled = 0;
+        while filled < chunk {
+            let n = reader.read(&mut buf[start + filled..])?;
+            if n == 0 {
+                break;
+            }
+            filled += n;
         }
-        let val = read_null_terminated_string(input)?;
-        map.insert(key, val);
-    }
-    Ok(map)
-}
-
-fn read_null_terminated_string<R: BufRead>(input: &mut R) -> Result<String, ScanError> {
-    let mut limited = input.take(MAX_PBO_STRING_LEN as u64);
-    let mut buf = Vec::new();
-    let bytes_read = limited.read_until(b'\0', &mut buf)?;
-
-    if bytes_read == 0 {
-        // EOF reached without data
-        return Ok(String::new());
-    }
-
-    if buf.last() != Some(&b'\0') {
-        // Did not find a null terminator within limit
-        return Err(ScanError::PboParse);
+        buf.truncate(start + filled);
+        let eof = filled < chunk;
+
+        match parse_pbo_header(&buf) {
+            Ok(_) => return Ok(buf),
+            // An incomplete buffer parses the same as a corrupt one, so only
+            // give up once the file is exhausted or the cap is hit.
+            Err(e) => {
+                if eof || buf.len() >= MAX_STREAM_HEADER_LEN {
+                    return Err(e);
+                }
+            }
+        }
+        chunk *= 2;
     }
-
-    buf.pop(); // remove null
-    Ok(String::from_utf8_lossy(&buf).to_string())
 }
 
 fn scan_pbo(fs_path: &Utf8Path, logical_path: &Utf8Path) -> Result<fleet_core::File, ScanError> {
     let file = File::open(fs_path)?;
     let mut reader = BufReader::new(file);
 
-    let (header_len, entries) = parse_pbo_metadata(&mut reader)?;
+    let header_buf = read_header_region(&mut reader)?;
+    let (header_len, entries) = parse_pbo_header(&header_buf)?;
 
     let mut parts = Vec::new();
     let mut current_offset: u64 = 0;
@@ -217,7 +441,7 @@ fn scan_pbo(fs_path: &Utf8Path, logical_path: &Utf8Path) -> Result<fleet_core::F
         current_offset += header_len;
     }
 
-    for entry in entries.iter() {
+    for entry in entries {
         let size = entry.data_size as u64;
 
         let mut hasher = Context::new();
@@ -234,7 +458,7 @@ fn scan_pbo(fs_path: &Utf8Path, logical_path: &Utf8Path) -> Result<fleet_core::F
         }
 
         parts.push(FilePart {
-            path: entry.filename.clone(),
+            path: entry.filename.into_owned(),
             length: size,
             start: current_offset,
             checksum: format!("{:X}", hasher.finalize()),
@@ -276,5 +500,202 @@ fn scan_pbo(fs_path: &Utf8Path, logical_path: &Utf8Path) -> Result<fleet_core::F
         checksum: format!("{:X}", hasher.finalize()),
         file_type: FileType::Pbo,
         parts,
+        canonical: Default::default(),
     })
 }
+
+// --- Streaming verification ---
+
+/// Incrementally computes the same checksum `scan_file` would produce, fed
+/// from an in-order byte stream (e.g. download chunks), so a freshly written
+/// file can be verified without re-reading it from disk.
+pub struct StreamingScanner {
+    inner: StreamingInner,
+}
+
+enum StreamingInner {
+    Raw(RawStreamState),
+    Pbo(PboStreamState),
+    Failed,
+}
+
+struct RawStreamState {
+    outer: Context,
+    part: Context,
+    part_len: u64,
+}
+
+struct PboStreamState {
+    /// Bytes buffered until the header can be parsed.
+    pending: Vec<u8>,
+    /// Cumulative end offsets of the header part and each entry part.
+    boundaries: Vec<u64>,
+    next_boundary: usize,
+    outer: Context,
+    part: Context,
+    trailing_len: u64,
+    pos: u64,
+    header_parsed: bool,
+}
+
+impl StreamingScanner {
+    pub fn new(logical_path: &Utf8Path) -> Self {
+        let extension = logical_path.extension().unwrap_or("").to_lowercase();
+        let inner = if extension == "pbo" {
+            StreamingInner::Pbo(PboStreamState {
+                pending: Vec::new(),
+                boundaries: Vec::new(),
+                next_boundary: 0,
+                outer: Context::new(),
+                part: Context::new(),
+                trailing_len: 0,
+                pos: 0,
+                header_parsed: false,
+            })
+        } else {
+            StreamingInner::Raw(RawStreamState {
+                outer: Context::new(),
+                part: Context::new(),
+                part_len: 0,
+            })
+        };
+        Self { inner }
+    }
+
+    pub fn update(&mut self, chunk: &[u8]) {
+        match &mut self.inner {
+            StreamingInner::Raw(s) => s.update(chunk),
+            StreamingInner::Pbo(s) => {
+                if !s.update(chunk) {
+                    self.inner = StreamingInner::Failed;
+                }
+            }
+            StreamingInner::Failed => {}
+        }
+    }
+
+    /// Final Swifty checksum, or `None` when streaming verification was not
+    /// possible (e.g. unparseable or truncated PBO); callers should then fall
+    /// back to hashing the file on disk.
+    pub fn finalize(self) -> Option<String> {
+        match self.inner {
+            StreamingInner::Raw(s) => Some(s.finalize()),
+            StreamingInner::Pbo(s) => s.finalize(),
+            StreamingInner::Failed => None,
+        }
+    }
+}
+
+impl RawStreamState {
+    fn update(&mut self, mut chunk: &[u8]) {
+        while !chunk.is_empty() {
+            let want = (RAW_CHUNK_SIZE - self.part_len).min(chunk.len() as u64) as usize;
+            self.part.consume(&chunk[..want]);
+            self.part_len += want as u64;
+            chunk = &chunk[want..];
+            if self.part_len == RAW_CHUNK_SIZE {
+                self.close_part();
+            }
+        }
+    }
+
+    fn close_part(&mut self) {
+        let part = std::mem::replace(&mut self.part, Context::new());
+        let hash = format!("{:X}", part.finalize());
+        self.outer.consume(hash.as_bytes());
+        self.part_len = 0;
+    }
+
+    fn finalize(mut self) -> String {
+        if self.part_len > 0 {
+            self.close_part();
+        }
+        format!("{:X}", self.outer.finalize())
+    }
+}
+
+impl PboStreamState {
+    /// Returns false when the header can never parse; the scanner then stops
+    /// consuming and reports failure at finalize.
+    fn update(&mut self, chunk: &[u8]) -> bool {
+        if !self.header_parsed {
+            self.pending.extend_from_slice(chunk);
+            // Filenames stay borrowed slices of `pending` here; only the
+            // entry sizes are needed for the part boundaries.
+            match parse_pbo_header(self.pending.as_slice()) {
+                Ok((header_len, entries)) => {
+                    let mut boundaries = Vec::with_capacity(entries.len() + 1);
+                    let mut offset = header_len;
+                    boundaries.push(offset);
+                    for entry in &entries {
+                        offset += entry.data_size as u64;
+                        boundaries.push(offset);
+                    }
+                    self.boundaries = boundaries;
+                    self.header_parsed = true;
+                    let pending = std::mem::take(&mut self.pending);
+                    self.consume(&pending);
+                }
+                Err(_) => {
+                    // A truncated buffer is indistinguishable from a corrupt
+                    // header (a cut-off filename parses as an error), so keep
+                    // buffering until the cap and only then give up.
+                    if self.pending.len() > MAX_STREAM_HEADER_LEN {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        self.consume(chunk);
+        true
+    }
+
+    fn consume(&mut self, mut chunk: &[u8]) {
+        while !chunk.is_empty() {
+            match self.boundaries.get(self.next_boundary) {
+                Some(&end) => {
+                    let want = (end - self.pos).min(chunk.len() as u64) as usize;
+                    self.part.consume(&chunk[..want]);
+                    self.pos += want as u64;
+                    chunk = &chunk[want..];
+                    if self.pos == end {
+                        self.close_part();
+                        self.next_boundary += 1;
+                        // Zero-size entries share the same boundary offset but
+                        // still contribute an (empty) part hash.
+                        while self.boundaries.get(self.next_boundary) == Some(&self.pos) {
+                            self.close_part();
+                            self.next_boundary += 1;
+                        }
+                    }
+                }
+                None => {
+                    // Data past the last entry becomes the $$END$$ part.
+                    self.part.consume(chunk);
+                    self.pos += chunk.len() as u64;
+                    self.trailing_len += chunk.len() as u64;
+                    chunk = &[];
+                }
+            }
+        }
+    }
+
+    fn close_part(&mut self) {
+        let part = std::mem::replace(&mut self.part, Context::new());
+        let hash = format!("{:X}", part.finalize());
+        self.outer.consume(hash.as_bytes());
+    }
+
+    fn finalize(mut self) -> Option<String> {
+        if !self.header_parsed || self.next_boundary < self.boundaries.len() {
+            // Header never parsed, or the stream ended before the entry table
+            // was satisfied: let the disk-based path decide.
+            return None;
+        }
+        if self.trailing_len > 0 {
+            self.close_part();
+        }
+        Some(format!("{:X}", self.outer.finalize()))
+    }
+}
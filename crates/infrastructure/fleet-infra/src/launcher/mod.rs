@@ -22,8 +22,11 @@ pub struct Launcher {
     template: String,
 }
 
+/// The fully resolved spawn: template applied, mod paths translated and
+/// injected. Public so callers can cache it (e.g. the CLI's warm-launch path)
+/// and later spawn it without re-resolving.
 #[derive(Debug, Clone, PartialEq, Eq)]
-pub(crate) struct ResolvedLaunchCommand {
+pub struct ResolvedLaunchCommand {
     pub program: String,
     pub args: Vec<String>,
     pub working_dir: std::path::PathBuf,
@@ -140,7 +143,7 @@ impl Launcher {
         }
     }
 
-    pub(crate) fn resolve_command(
+    pub fn resolve_command(
         &self,
         mods: Vec<Utf8PathBuf>,
     ) -> Result<ResolvedLaunchCommand, LaunchError> {
@@ -208,7 +211,12 @@ impl Launcher {
 
     pub fn launch(&self, mods: Vec<Utf8PathBuf>) -> Result<(), LaunchError> {
         let cmd = self.resolve_command(mods)?;
+        Self::spawn_resolved(&cmd)
+    }
 
+    /// Spawns an already-resolved command, skipping template and path
+    /// resolution entirely.
+    pub fn spawn_resolved(cmd: &ResolvedLaunchCommand) -> Result<(), LaunchError> {
         // Log the resolved command so it can be inspected when debugging launch issues.
         eprintln!(
             "[fleet] Launching program: {:?}, args: {:?}, cwd: {:?}",
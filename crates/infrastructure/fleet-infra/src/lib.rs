@@ -3,6 +3,8 @@ pub mod launcher;
 pub mod net;
 
 // Re-exports for convenience
-pub use hashing::{compute_file_checksum, scan_file, ScanError};
+pub use hashing::{
+    compute_file_checksum, fast_file_digest, scan_file, ScanError, StreamingScanner,
+};
 pub use launcher::{LaunchError, Launcher};
 pub use net::{DownloadEvent, DownloadRequest, DownloadResult, Downloader};
@@ -0,0 +1,116 @@
+use camino::Utf8Path;
+use fleet_core::{DeltaSegment, FileDelta};
+use futures::StreamExt;
+use reqwest::{Client, StatusCode};
+use std::sync::Arc;
+use std::time::Instant;
+use tokio::fs::File;
+use tokio::io::{AsyncReadExt, AsyncSeekExt, AsyncWriteExt, SeekFrom};
+use super::{ByteLimiter, ProgressSink};
+
+const COPY_BUF_SIZE: usize = 1024 * 1024;
+
+#[derive(Debug, thiserror::Error)]
+pub enum DeltaError {
+    #[error("IO error: {0}")]
+    Io(#[from] std::io::Error),
+    #[error("Range request failed: {0}")]
+    Http(#[from] reqwest::Error),
+    #[error("Server does not support Range requests (got {0})")]
+    RangeUnsupported(StatusCode),
+    #[error("Range response size mismatch: expected {expected}, got {actual}")]
+    SizeMismatch { expected: u64, actual: u64 },
+}
+
+/// Rebuild `dest` from reusable parts of `source` plus HTTP Range fetches,
+/// following the segment plan in `delta`.
+///
+/// Returns the number of bytes that actually crossed the network. Any error
+/// leaves the caller free to fall back to a plain full-file download.
+pub(super) async fn apply_delta(
+    client: &Client,
+    url: &str,
+    source: &Utf8Path,
+    dest: &Utf8Path,
+    delta: &FileDelta,
+    sink: &ProgressSink,
+    lim: &Option<Arc<ByteLimiter>>,
+) -> Result<u64, DeltaError> {
+    let mut src = File::open(source.as_std_path()).await?;
+    let mut out = File::create(dest.as_std_path()).await?;
+
+    let mut fetched: u64 = 0;
+    let mut accumulated: u64 = 0;
+    let mut rate_debt: u64 = 0;
+    let mut last_emit = Instant::now();
+    let mut copy_buf = vec![0u8; COPY_BUF_SIZE];
+
+    for segment in &delta.segments {
+        match segment {
+            DeltaSegment::CopyLocal {
+                local_start,
+                length,
+            } => {
+                src.seek(SeekFrom::Start(*local_start)).await?;
+                let mut remaining = *length;
+                while remaining > 0 {
+                    let want = remaining.min(copy_buf.len() as u64) as usize;
+                    let n = src.read(&mut copy_buf[..want]).await?;
+                    if n == 0 {
+                        // Local file shorter than the part table claims.
+                        return Err(DeltaError::SizeMismatch {
+                            expected: *length,
+                            actual: *length - remaining,
+                        });
+                    }
+                    out.write_all(&copy_buf[..n]).await?;
+                    remaining -= n as u64;
+                    accumulated += n as u64;
+                }
+            }
+            DeltaSegment::Fetch {
+                remote_start,
+                length,
+            } => {
+                let range = format!("bytes={}-{}", remote_start, remote_start + length - 1);
+                let resp = client.get(url).header("Range", range).send().await?;
+                if resp.status() != StatusCode::PARTIAL_CONTENT {
+                    return Err(DeltaError::RangeUnsupported(resp.status()));
+                }
+
+                let mut written: u64 = 0;
+                let mut stream = resp.bytes_stream();
+                while let Some(chunk_res) = stream.next().await {
+                    let chunk = chunk_res?;
+                    if let Some(l) = lim {
+                        l.charge(&mut rate_debt, chunk.len() as u64).await;
+                    }
+                    out.write_all(&chunk).await?;
+                    written += chunk.len() as u64;
+                    accumulated += chunk.len() as u64;
+
+                    if accumulated > 1_000_000 || last_emit.elapsed().as_millis() > 100 {
+                        sink.add(accumulated).await;
+                        accumulated = 0;
+                        last_emit = Instant::now();
+                    }
+                }
+
+                if written != *length {
+                    return Err(DeltaError::SizeMismatch {
+                        expected: *length,
+                        actual: written,
+                    });
+                }
+                fetched += written;
+            }
+        }
+    }
+
+    if accumulated > 0 {
+        sink.add(accumulated).await;
+    }
+
+    out.flush().await?;
+    Ok(fetched)
+}
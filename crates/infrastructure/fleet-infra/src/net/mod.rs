@@ -12,7 +12,162 @@ use std::time::Instant;
 use tokio::fs::File;
 use tokio::io::AsyncWriteExt;
 use tokio::sync::mpsc::Sender;
-use tracing::warn;
+use tracing::{debug, warn};
+
+mod delta;
+
+/// Disk writes are coalesced into blocks of this size so large files land in
+/// a few sequential writes instead of one syscall per network chunk.
+const WRITE_BUF_CAPACITY: usize = 4 * 1024 * 1024;
+
+/// One governor token buys this many bytes.
+const TOKEN_BYTES: u64 = 1024;
+/// Accumulate at least this much debt before paying the limiter.
+const CHARGE_THRESHOLD: u64 = 256 * 1024;
+
+/// Bandwidth limiter expressed in bytes per second.
+///
+/// governor quotas are u32-bound, so tokens are counted in KiB — that moves
+/// the expressible ceiling from 4 GB/s to 4 TB/s. Callers charge bytes into a
+/// local debt counter and the limiter is only awaited once a whole batch of
+/// chunks has accumulated, keeping the per-chunk fast path to an integer add.
+pub(crate) struct ByteLimiter {
+    inner: RateLimiter<NotKeyed, InMemoryState, DefaultClock, NoOpMiddleware>,
+    /// Tokens replenished per second; also the largest single acquisition the
+    /// quota can satisfy.
+    burst: u32,
+    /// Cumulative time downloads have spent parked in the limiter, for perf
+    /// reporting.
+    wait_nanos: std::sync::atomic::AtomicU64,
+}
+
+/// How long a mirror sits out after a transport-level failure before
+/// requests start probing it again.
+const MIRROR_BACKOFF: Duration = Duration::from_secs(15);
+
+#[derive(Default)]
+struct HostStat {
+    bytes: u64,
+    nanos: u64,
+    in_flight: u32,
+    dead_until: Option<Instant>,
+}
+
+/// Tracks measured throughput per mirror host so each new download is steered
+/// toward the host with the most headroom, while unmeasured hosts rank first
+/// so every mirror gets probed early in the batch.
+#[derive(Default)]
+pub(crate) struct MirrorSelector {
+    hosts: std::sync::Mutex<std::collections::HashMap<String, HostStat>>,
+}
+
+impl MirrorSelector {
+    /// `scheme://host[:port]` prefix, which is what throughput is keyed by.
+    fn host_of(url: &str) -> String {
+        url.split('/').take(3).collect::<Vec<_>>().join("/")
+    }
+
+    /// Candidate URLs for one file, best mirror first.
+    fn order(&self, primary: &str, alts: &[String]) -> Vec<String> {
+        let mut all: Vec<String> = std::iter::once(primary.to_string())
+            .chain(alts.iter().cloned())
+            .collect();
+        if all.len() > 1 {
+            let now = Instant::now();
+            let hosts = self.hosts.lock().unwrap();
+            all.sort_by(|a, b| {
+                let (sa, sb) = (Self::score(&hosts, a, now), Self::score(&hosts, b, now));
+                sb.partial_cmp(&sa).unwrap_or(std::cmp::Ordering::Equal)
+            });
+        }
+        all
+    }
+
+    /// Estimated throughput left for one more connection on this host.
+    fn score(
+        hosts: &std::collections::HashMap<String, HostStat>,
+        url: &str,
+        now: Instant,
+    ) -> f64 {
+        let Some(h) = hosts.get(&Self::host_of(url)) else {
+            return f64::INFINITY;
+        };
+        if h.dead_until.is_some_and(|t| t > now) {
+            return f64::NEG_INFINITY;
+        }
+        if h.nanos == 0 {
+            return f64::INFINITY;
+        }
+        let bps = h.bytes as f64 / (h.nanos as f64 / 1e9);
+        bps / (h.in_flight as f64 + 1.0)
+    }
+
+    fn begin(&self, url: &str) {
+        let mut hosts = self.hosts.lock().unwrap();
+        hosts.entry(Self::host_of(url)).or_default().in_flight += 1;
+    }
+
+    fn finish(&self, url: &str, bytes: u64, elapsed: Duration) {
+        let mut hosts = self.hosts.lock().unwrap();
+        let h = hosts.entry(Self::host_of(url)).or_default();
+        h.in_flight = h.in_flight.saturating_sub(1);
+        h.bytes += bytes;
+        h.nanos += elapsed.as_nanos() as u64;
+        if bytes > 0 {
+            h.dead_until = None;
+        }
+    }
+
+    fn mark_failed(&self, url: &str) {
+        let mut hosts = self.hosts.lock().unwrap();
+        hosts.entry(Self::host_of(url)).or_default().dead_until =
+            Some(Instant::now() + MIRROR_BACKOFF);
+    }
+}
+
+impl ByteLimiter {
+    fn new(bytes_per_sec: u64) -> Option<Arc<Self>> {
+        // Rates under 1 KiB/s round up to the smallest expressible quota.
+        let tokens = (bytes_per_sec / TOKEN_BYTES).clamp(1, u32::MAX as u64) as u32;
+        NonZeroU32::new(tokens).map(|nz| {
+            Arc::new(Self {
+                inner: RateLimiter::direct(Quota::per_second(nz)),
+                burst: tokens,
+                wait_nanos: std::sync::atomic::AtomicU64::new(0),
+            })
+        })
+    }
+
+    /// Total time spent blocked on the limiter so far.
+    pub(crate) fn waited(&self) -> Duration {
+        Duration::from_nanos(self.wait_nanos.load(std::sync::atomic::Ordering::Relaxed))
+    }
+
+    /// Charge `bytes` against `debt`, awaiting the limiter only once enough
+    /// debt has built up to be worth a governor round-trip.
+    pub(crate) async fn charge(&self, debt: &mut u64, bytes: u64) {
+        *debt += bytes;
+        if *debt < CHARGE_THRESHOLD {
+            return;
+        }
+        let mut tokens = *debt / TOKEN_BYTES;
+        *debt %= TOKEN_BYTES;
+        // Split the acquisition so it never exceeds the quota's burst
+        // capacity, which until_n_ready would reject outright.
+        let parked = Instant::now();
+        while tokens > 0 {
+            let take = tokens.min(self.burst as u64) as u32;
+            if let Some(nz) = NonZeroU32::new(take) {
+                let _ = self.inner.until_n_ready(nz).await;
+            }
+            tokens -= take as u64;
+        }
+        self.wait_nanos.fetch_add(
+            parked.elapsed().as_nanos() as u64,
+            std::sync::atomic::Ordering::Relaxed,
+        );
+    }
+}
 
 #[derive(Debug)]
 struct PartFileCleanup {
@@ -50,9 +205,16 @@ pub fn default_http_client() -> Result<Client, reqwest::Error> {
 pub struct DownloadRequest {
     pub id: u64,
     pub url: String,
+    /// The same file on alternate mirrors. Batches spread load across these
+    /// by measured throughput, and a mirror that fails at the request stage
+    /// rotates to the next one without consuming a retry attempt.
+    pub mirror_urls: Vec<String>,
     pub target_path: Utf8PathBuf,
     pub expected_size: u64,
     pub expected_checksum: Option<String>,
+    /// When present, try to rebuild the file from the existing copy at
+    /// `target_path` plus HTTP Range fetches before downloading it whole.
+    pub delta: Option<fleet_core::FileDelta>,
 }
 
 #[derive(Debug, Clone)]
@@ -60,6 +222,9 @@ pub struct DownloadResult {
     pub id: u64,
     pub success: bool,
     pub bytes_downloaded: u64,
+    /// Wall time from the request entering a concurrency slot to finishing
+    /// (including verification); stamped by `download_batch`.
+    pub elapsed: Duration,
 }
 
 #[derive(Debug)]
@@ -67,12 +232,79 @@ pub enum DownloadEvent {
     Started { id: u64, total_bytes: u64 },
     Progress { id: u64, bytes_delta: u64 },
     Completed { id: u64, success: bool },
+    /// Every planned download for this mod finished successfully. Emitted by
+    /// the plan executor (which knows the mod grouping), not the downloader.
+    ModCompleted { mod_name: String },
+}
+
+/// Shared per-download byte counters: the sampling alternative to
+/// [`DownloadEvent::Progress`]. Each transfer bumps its slot with a relaxed
+/// atomic add, so a consumer (e.g. a UI) reads progress at its own frame
+/// rate instead of waking once per network chunk; the event channel then
+/// carries only Started/Completed state transitions.
+#[derive(Default)]
+pub struct ProgressTable {
+    slots: std::sync::Mutex<std::collections::HashMap<u64, Arc<std::sync::atomic::AtomicU64>>>,
+}
+
+impl ProgressTable {
+    fn slot(&self, id: u64) -> Arc<std::sync::atomic::AtomicU64> {
+        self.slots.lock().unwrap().entry(id).or_default().clone()
+    }
+
+    /// Bytes reported so far for the given download id.
+    pub fn bytes(&self, id: u64) -> u64 {
+        self.slots
+            .lock()
+            .unwrap()
+            .get(&id)
+            .map(|s| s.load(std::sync::atomic::Ordering::Relaxed))
+            .unwrap_or(0)
+    }
+}
+
+impl std::fmt::Debug for ProgressTable {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.write_str("ProgressTable")
+    }
+}
+
+/// Where a transfer reports its byte progress. With a [`ProgressTable`]
+/// attached the hot path is an atomic add that never wakes the consumer;
+/// otherwise deltas go out as [`DownloadEvent::Progress`] sends.
+pub(crate) enum ProgressSink {
+    Counter(Arc<std::sync::atomic::AtomicU64>),
+    Channel { tx: Sender<DownloadEvent>, id: u64 },
+    Null,
+}
+
+impl ProgressSink {
+    pub(crate) async fn add(&self, bytes: u64) {
+        if bytes == 0 {
+            return;
+        }
+        match self {
+            Self::Counter(slot) => {
+                slot.fetch_add(bytes, std::sync::atomic::Ordering::Relaxed);
+            }
+            Self::Channel { tx, id } => {
+                let _ = tx
+                    .send(DownloadEvent::Progress {
+                        id: *id,
+                        bytes_delta: bytes,
+                    })
+                    .await;
+            }
+            Self::Null => {}
+        }
+    }
 }
 
 pub struct Downloader {
     client: Client,
     concurrency: usize,
     rate_limit_bytes: Option<u64>,
+    progress_table: Option<Arc<ProgressTable>>,
 }
 
 impl Downloader {
@@ -81,38 +313,139 @@ impl Downloader {
             client,
             concurrency,
             rate_limit_bytes,
+            progress_table: None,
         }
     }
 
+    /// Route byte progress into `table` instead of the event channel. The
+    /// channel (when provided) still carries Started/Completed transitions.
+    pub fn with_progress_table(mut self, table: Arc<ProgressTable>) -> Self {
+        self.progress_table = Some(table);
+        self
+    }
+
     /// Generic batch download. Does NOT handle deletes, renames, or domain logic.
     pub async fn download_batch(
         &self,
         items: Vec<DownloadRequest>,
         progress_tx: Option<Sender<DownloadEvent>>,
     ) -> Vec<DownloadResult> {
-        let limiter = self.rate_limit_bytes.and_then(|bps| {
-            NonZeroU32::new(bps as u32)
-                .map(|nz| Arc::new(RateLimiter::direct(Quota::per_second(nz))))
-        });
+        self.download_batch_timed(items, progress_tx).await.0
+    }
+
+    /// Like [`download_batch`](Self::download_batch), but also reports the
+    /// total time the batch spent parked in the rate limiter, and stamps each
+    /// result's `elapsed` with its wall time in a concurrency slot.
+    pub async fn download_batch_timed(
+        &self,
+        items: Vec<DownloadRequest>,
+        progress_tx: Option<Sender<DownloadEvent>>,
+    ) -> (Vec<DownloadResult>, Duration) {
+        let limiter = self.rate_limit_bytes.and_then(ByteLimiter::new);
+        let mirrors = Arc::new(MirrorSelector::default());
         // FIX: Use buffer_unordered to drive concurrency without deadlock
-        stream::iter(items)
+        let results = stream::iter(items)
             .map(|item| {
                 let client = self.client.clone();
                 let tx = progress_tx.clone();
+                let sink = match (&self.progress_table, &tx) {
+                    (Some(table), _) => ProgressSink::Counter(table.slot(item.id)),
+                    (None, Some(tx)) => ProgressSink::Channel {
+                        tx: tx.clone(),
+                        id: item.id,
+                    },
+                    (None, None) => ProgressSink::Null,
+                };
                 let lim = limiter.clone();
+                let sel = mirrors.clone();
 
-                async move { Self::download_single(client, item, tx, lim).await }
+                async move {
+                    let started = Instant::now();
+                    let mut res = Self::download_single(client, item, tx, sink, lim, sel).await;
+                    res.elapsed = started.elapsed();
+                    res
+                }
             })
             .buffer_unordered(self.concurrency)
             .collect()
-            .await
+            .await;
+        let waited = limiter.map(|l| l.waited()).unwrap_or(Duration::ZERO);
+        (results, waited)
+    }
+
+    /// Verification: if an expected checksum is provided, compute it using
+    /// `fleet-hashing` before the caller commits the file to the final path.
+    async fn verify_part_file(
+        tmp_path: &Utf8PathBuf,
+        target_path: &Utf8PathBuf,
+        expected_checksum: &Option<String>,
+    ) -> bool {
+        let Some(expected) = expected_checksum else {
+            return true;
+        };
+
+        let tmp_path_clone = tmp_path.clone();
+        let target_filename = target_path
+            .file_name()
+            .map(|s| s.to_string())
+            .unwrap_or_default();
+
+        let check_res = tokio::task::spawn_blocking(move || {
+            let logical = camino::Utf8Path::new(&target_filename);
+            crate::hashing::compute_file_checksum(&tmp_path_clone, logical).ok()
+        })
+        .await;
+
+        match check_res {
+            Ok(Some(actual)) => {
+                if actual.eq_ignore_ascii_case(expected) {
+                    true
+                } else {
+                    warn!(
+                        "Checksum mismatch for {}: expected {}, got {}",
+                        target_path, expected, actual
+                    );
+                    false
+                }
+            }
+            _ => {
+                warn!("Failed to compute checksum for {}", target_path);
+                false
+            }
+        }
+    }
+
+    /// Replay the first `len` bytes of an existing .part file into `hasher` so
+    /// a resumed download still produces a full-file streaming checksum.
+    async fn hash_existing_prefix(
+        hasher: &mut crate::hashing::StreamingScanner,
+        tmp_path: &Utf8PathBuf,
+        len: u64,
+    ) -> std::io::Result<()> {
+        use tokio::io::AsyncReadExt;
+
+        let mut file = File::open(tmp_path.as_std_path()).await?;
+        let mut remaining = len;
+        let mut buf = vec![0u8; 1_000_000];
+        while remaining > 0 {
+            let want = buf.len().min(remaining as usize);
+            let read = file.read(&mut buf[..want]).await?;
+            if read == 0 {
+                return Err(std::io::Error::from(std::io::ErrorKind::UnexpectedEof));
+            }
+            hasher.update(&buf[..read]);
+            remaining -= read as u64;
+        }
+        Ok(())
     }
 
     async fn download_single(
         client: Client,
         req: DownloadRequest,
         tx: Option<Sender<DownloadEvent>>,
-        lim: Option<Arc<RateLimiter<NotKeyed, InMemoryState, DefaultClock, NoOpMiddleware>>>,
+        sink: ProgressSink,
+        lim: Option<Arc<ByteLimiter>>,
+        sel: Arc<MirrorSelector>,
     ) -> DownloadResult {
         if let Some(ref t) = tx {
             let _ = t
@@ -133,40 +466,207 @@ impl Downloader {
         let mut success = false;
         let mut total_written = 0;
 
-        for _attempt in 0..3 {
-            if let Ok(resp) = client.get(&req.url).send().await {
+        // A .part file of exactly the expected size may be a download a
+        // previous run finished but was killed before committing: verify it
+        // and adopt it without touching the network.
+        if req.expected_size > 0 {
+            if let Ok(meta) = tokio::fs::metadata(tmp_path.as_std_path()).await {
+                if meta.len() == req.expected_size
+                    && Self::verify_part_file(&tmp_path, &req.target_path, &req.expected_checksum)
+                        .await
+                    && tokio::fs::rename(tmp_path.as_std_path(), req.target_path.as_std_path())
+                        .await
+                        .is_ok()
+                {
+                    tmp_cleanup.disarm();
+                    if let Some(ref t) = tx {
+                        let _ = t
+                            .send(DownloadEvent::Completed {
+                                id: req.id,
+                                success: true,
+                            })
+                            .await;
+                    }
+                    return DownloadResult {
+                        id: req.id,
+                        success: true,
+                        bytes_downloaded: 0,
+                        elapsed: Duration::ZERO,
+                    };
+                }
+            }
+        }
+
+        // Delta path: splice reusable local parts with Range fetches. Any
+        // failure (no Range support, local file diverged, ...) falls through
+        // to the plain full-file download below.
+        if let Some(ref plan) = req.delta {
+            match delta::apply_delta(
+                &client,
+                &req.url,
+                &req.target_path,
+                &tmp_path,
+                plan,
+                &sink,
+                &lim,
+            )
+            .await
+            {
+                Ok(fetched) => {
+                    if Self::verify_part_file(&tmp_path, &req.target_path, &req.expected_checksum)
+                        .await
+                        && tokio::fs::rename(tmp_path.as_std_path(), req.target_path.as_std_path())
+                            .await
+                            .is_ok()
+                    {
+                        tmp_cleanup.disarm();
+                        if let Some(ref t) = tx {
+                            let _ = t
+                                .send(DownloadEvent::Completed {
+                                    id: req.id,
+                                    success: true,
+                                })
+                                .await;
+                        }
+                        return DownloadResult {
+                            id: req.id,
+                            success: true,
+                            bytes_downloaded: fetched,
+                            elapsed: Duration::ZERO,
+                        };
+                    }
+                    warn!(
+                        "Delta result for {} failed verification; falling back to full download",
+                        req.url
+                    );
+                }
+                Err(e) => {
+                    debug!(
+                        "Delta download for {} not applicable ({e}); falling back to full download",
+                        req.url
+                    );
+                }
+            }
+            // Spliced delta output is not a prefix of the remote file, so it
+            // must not be picked up by the resume logic below.
+            let _ = tokio::fs::remove_file(tmp_path.as_std_path()).await;
+        }
+
+        for attempt in 0..3 {
+            // Resume partial data left by an earlier attempt (or a previous
+            // run) instead of repaying bytes that are already on disk. A
+            // full-size .part failed verification above, so it is stale.
+            let resume_offset = match tokio::fs::metadata(tmp_path.as_std_path()).await {
+                Ok(meta) if meta.len() > 0 && meta.len() < req.expected_size => meta.len(),
+                Ok(meta) if meta.len() > 0 => {
+                    let _ = tokio::fs::remove_file(tmp_path.as_std_path()).await;
+                    0
+                }
+                _ => 0,
+            };
+
+            // Try mirrors best-first. A host that fails at the request stage
+            // (refused connection, DNS, timeout) goes into backoff and the
+            // next mirror is tried immediately instead of burning the attempt.
+            let mut picked = None;
+            for url in sel.order(&req.url, &req.mirror_urls) {
+                let mut request = client.get(&url);
+                if resume_offset > 0 {
+                    request = request.header("Range", format!("bytes={resume_offset}-"));
+                }
+                match request.send().await {
+                    Ok(resp) => {
+                        picked = Some((url, resp));
+                        break;
+                    }
+                    Err(e) => {
+                        debug!("Mirror {} failed for {}: {e}", MirrorSelector::host_of(&url), req.url);
+                        sel.mark_failed(&url);
+                    }
+                }
+            }
+
+            if let Some((used_url, resp)) = picked {
+                let resuming =
+                    resume_offset > 0 && resp.status() == reqwest::StatusCode::PARTIAL_CONTENT;
                 if resp.status().is_success() {
-                    if let Ok(mut file) = File::create(tmp_path.as_std_path()).await {
+                    let file_res = if resuming {
+                        tokio::fs::OpenOptions::new()
+                            .append(true)
+                            .open(tmp_path.as_std_path())
+                            .await
+                    } else {
+                        // Full body (the server may have ignored the Range
+                        // header and answered 200): start from byte zero.
+                        match File::create(tmp_path.as_std_path()).await {
+                            Ok(f) => {
+                                // Reserve the final size up front so the
+                                // filesystem can lay the file out contiguously
+                                // instead of growing it chunk by chunk.
+                                if req.expected_size > 0 {
+                                    let _ = f.set_len(req.expected_size).await;
+                                }
+                                Ok(f)
+                            }
+                            Err(e) => Err(e),
+                        }
+                    };
+                    // Bytes already on disk before this attempt wrote anything.
+                    let base_offset = if resuming { resume_offset } else { 0 };
+                    if let Ok(file) = file_res {
+                        sel.begin(&used_url);
+                        let stream_started = Instant::now();
+                        let mut file = tokio::io::BufWriter::with_capacity(WRITE_BUF_CAPACITY, file);
                         let mut stream = resp.bytes_stream();
                         let mut write_err = false;
+                        let mut attempt_written = 0u64;
+                        let mut rate_debt = 0u64;
 
                         let mut accumulated = 0u64;
                         let mut last_emit = Instant::now();
 
+                        // Hash chunks as they arrive so verification is done the
+                        // moment the stream ends instead of re-reading the .part
+                        // file from disk.
+                        let mut hasher = req.expected_checksum.as_ref().map(|_| {
+                            let name = req.target_path.file_name().unwrap_or_default();
+                            crate::hashing::StreamingScanner::new(camino::Utf8Path::new(name))
+                        });
+                        if resuming {
+                            if let Some(h) = hasher.as_mut() {
+                                if Self::hash_existing_prefix(h, &tmp_path, resume_offset)
+                                    .await
+                                    .is_err()
+                                {
+                                    hasher = None;
+                                }
+                            }
+                            // Bytes inherited from a previous run have not
+                            // been reported on this progress channel yet.
+                            if attempt == 0 {
+                                sink.add(resume_offset).await;
+                            }
+                        }
+
                         while let Some(chunk_res) = stream.next().await {
                             match chunk_res {
                                 Ok(chunk) => {
                                     if let Some(l) = &lim {
-                                        if let Some(nz) = NonZeroU32::new(chunk.len() as u32) {
-                                            l.until_n_ready(nz).await.ok();
-                                        }
+                                        l.charge(&mut rate_debt, chunk.len() as u64).await;
+                                    }
+                                    if let Some(h) = hasher.as_mut() {
+                                        h.update(&chunk);
                                     }
                                     if file.write_all(&chunk).await.is_ok() {
                                         let len = chunk.len() as u64;
                                         total_written += len;
+                                        attempt_written += len;
                                         accumulated += len;
 
                                         if accumulated > 1_000_000
                                             || last_emit.elapsed().as_millis() > 100
                                         {
-                                            if let Some(ref t) = tx {
-                                                let _ = t
-                                                    .send(DownloadEvent::Progress {
-                                                        id: req.id,
-                                                        bytes_delta: accumulated,
-                                                    })
-                                                    .await;
-                                            }
+                                            sink.add(accumulated).await;
                                             accumulated = 0;
                                             last_emit = Instant::now();
                                         }
@@ -183,53 +683,51 @@ impl Downloader {
                         }
 
                         if accumulated > 0 {
-                            if let Some(ref t) = tx {
-                                let _ = t
-                                    .send(DownloadEvent::Progress {
-                                        id: req.id,
-                                        bytes_delta: accumulated,
-                                    })
-                                    .await;
-                            }
+                            sink.add(accumulated).await;
                         }
 
-                        if !write_err {
-                            let _ = file.flush().await;
-
-                            // Verification: if an expected checksum is provided, compute it
-                            // using `fleet-hashing` before committing the file to the final path.
-                            let mut verified = true;
-                            if let Some(expected) = &req.expected_checksum {
-                                let tmp_path_clone = tmp_path.clone();
-                                let target_filename = req
-                                    .target_path
-                                    .file_name()
-                                    .map(|s| s.to_string())
-                                    .unwrap_or_default();
-
-                                let check_res = tokio::task::spawn_blocking(move || {
-                                    let logical = camino::Utf8Path::new(&target_filename);
-                                    crate::hashing::compute_file_checksum(&tmp_path_clone, logical)
-                                        .ok()
-                                })
-                                .await;
+                        // With a multi-MB buffer in play, a failed flush means
+                        // real data never reached the disk. Flush even after a
+                        // write error so the truncation below keeps as much
+                        // resumable data as possible.
+                        if file.flush().await.is_err() {
+                            write_err = true;
+                        }
+                        // Trim any preallocated tail the stream did not cover
+                        // (short body, write failure, or a server that ignored
+                        // Range) so the resume logic above only ever sees bytes
+                        // that actually arrived.
+                        let _ = file.get_mut().set_len(base_offset + attempt_written).await;
 
-                                match check_res {
-                                    Ok(Some(actual)) => {
-                                        if !actual.eq_ignore_ascii_case(expected) {
-                                            warn!(
-                                                "Checksum mismatch for {}: expected {}, got {}",
-                                                req.url, expected, actual
-                                            );
-                                            verified = false;
-                                        }
-                                    }
-                                    _ => {
-                                        warn!("Failed to compute checksum for {}", req.url);
-                                        verified = false;
+                        sel.finish(&used_url, attempt_written, stream_started.elapsed());
+
+                        if !write_err {
+                            let streamed = hasher
+                                .take()
+                                .and_then(crate::hashing::StreamingScanner::finalize);
+                            let verified = match (&req.expected_checksum, streamed) {
+                                (Some(expected), Some(actual)) => {
+                                    let ok = actual.eq_ignore_ascii_case(expected);
+                                    if !ok {
+                                        warn!(
+                                            "Checksum mismatch for {}: expected {}, got {}",
+                                            req.url, expected, actual
+                                        );
                                     }
+                                    ok
                                 }
-                            }
+                                // Streaming could not produce a checksum (e.g.
+                                // unparseable PBO): fall back to re-reading the
+                                // .part file from disk.
+                                _ => {
+                                    Self::verify_part_file(
+                                        &tmp_path,
+                                        &req.target_path,
+                                        &req.expected_checksum,
+                                    )
+                                    .await
+                                }
+                            };
 
                             if verified
                                 && tokio::fs::rename(
@@ -245,13 +743,26 @@ impl Downloader {
                             }
                         }
                     }
+                } else if resume_offset > 0 {
+                    // The server rejected the Range request (e.g. 416); retry
+                    // from scratch rather than re-asking for the same range.
+                    let _ = tokio::fs::remove_file(tmp_path.as_std_path()).await;
                 }
             }
             tokio::time::sleep(std::time::Duration::from_millis(500)).await;
         }
 
         if !success {
-            let _ = tokio::fs::remove_file(&tmp_path).await;
+            // Keep a genuine partial so the next run can resume it; empty or
+            // full-size-but-unverified files are worthless and get discarded.
+            match tokio::fs::metadata(tmp_path.as_std_path()).await {
+                Ok(meta) if meta.len() > 0 && meta.len() < req.expected_size => {
+                    tmp_cleanup.disarm();
+                }
+                _ => {
+                    let _ = tokio::fs::remove_file(&tmp_path).await;
+                }
+            }
         }
 
         if let Some(ref t) = tx {
@@ -267,6 +778,7 @@ impl Downloader {
             id: req.id,
             success,
             bytes_downloaded: total_written,
+            elapsed: Duration::ZERO,
         }
     }
 }
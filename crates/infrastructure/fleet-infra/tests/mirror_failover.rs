@@ -0,0 +1,118 @@
+use axum::extract::State;
+use axum::response::{IntoResponse, Response};
+use axum::{body::Body, routing::get, Router};
+use camino::{Utf8Path, Utf8PathBuf};
+use fleet_infra::{DownloadRequest, Downloader};
+use std::net::SocketAddr;
+use std::sync::{Arc, Mutex};
+use tempfile::tempdir;
+
+#[derive(Clone)]
+struct ServerState {
+    file_bytes: Arc<Vec<u8>>,
+    hits: Arc<Mutex<u32>>,
+}
+
+async fn serve_file(State(state): State<ServerState>) -> Response {
+    *state.hits.lock().unwrap() += 1;
+    Body::from(state.file_bytes.as_ref().clone()).into_response()
+}
+
+async fn start_server(state: ServerState) -> (SocketAddr, tokio::task::JoinHandle<()>) {
+    let app = Router::new()
+        .route("/file.bin", get(serve_file))
+        .with_state(state);
+    let listener = tokio::net::TcpListener::bind("127.0.0.1:0").await.unwrap();
+    let addr = listener.local_addr().unwrap();
+    let handle = tokio::spawn(async move {
+        axum::serve(listener, app).await.unwrap();
+    });
+    (addr, handle)
+}
+
+fn request_for(url: String, mirror_urls: Vec<String>, target: Utf8PathBuf, content: &[u8]) -> DownloadRequest {
+    let dir = tempdir().unwrap();
+    let seed = dir.path().join("seed.bin");
+    std::fs::write(&seed, content).unwrap();
+    let checksum = fleet_infra::hashing::compute_file_checksum(
+        Utf8Path::from_path(&seed).unwrap(),
+        Utf8Path::new("file.bin"),
+    )
+    .unwrap();
+
+    DownloadRequest {
+        id: 1,
+        url,
+        mirror_urls,
+        target_path: target,
+        expected_size: content.len() as u64,
+        expected_checksum: Some(checksum),
+        delta: None,
+    }
+}
+
+#[tokio::test]
+async fn dead_primary_fails_over_to_mirror() {
+    let content: Vec<u8> = (0..100_000u32).map(|i| (i % 251) as u8).collect();
+    let state = ServerState {
+        file_bytes: Arc::new(content.clone()),
+        hits: Arc::new(Mutex::new(0)),
+    };
+    let (mirror_addr, handle) = start_server(state.clone()).await;
+
+    // Reserve a port and close the listener: nothing answers here.
+    let dead = tokio::net::TcpListener::bind("127.0.0.1:0").await.unwrap();
+    let dead_addr = dead.local_addr().unwrap();
+    drop(dead);
+
+    let dir = tempdir().unwrap();
+    let root = Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+    let target = root.join("file.bin");
+
+    let downloader = Downloader::new(reqwest::Client::new(), 1, None);
+    let req = request_for(
+        format!("http://{dead_addr}/file.bin"),
+        vec![format!("http://{mirror_addr}/file.bin")],
+        target.clone(),
+        &content,
+    );
+    let results = downloader.download_batch(vec![req], None).await;
+
+    assert!(results[0].success, "mirror should have served the file");
+    assert_eq!(
+        *state.hits.lock().unwrap(),
+        1,
+        "failover should not burn retries re-probing the dead host"
+    );
+    assert_eq!(std::fs::read(target.as_std_path()).unwrap(), content);
+
+    handle.abort();
+}
+
+#[tokio::test]
+async fn mirrorless_request_still_downloads_from_primary() {
+    let content: Vec<u8> = (0..50_000u32).map(|i| (i % 241) as u8).collect();
+    let state = ServerState {
+        file_bytes: Arc::new(content.clone()),
+        hits: Arc::new(Mutex::new(0)),
+    };
+    let (addr, handle) = start_server(state.clone()).await;
+
+    let dir = tempdir().unwrap();
+    let root = Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+    let target = root.join("file.bin");
+
+    let downloader = Downloader::new(reqwest::Client::new(), 1, None);
+    let req = request_for(
+        format!("http://{addr}/file.bin"),
+        Vec::new(),
+        target.clone(),
+        &content,
+    );
+    let results = downloader.download_batch(vec![req], None).await;
+
+    assert!(results[0].success);
+    assert_eq!(std::fs::read(target.as_std_path()).unwrap(), content);
+
+    handle.abort();
+}
@@ -0,0 +1,161 @@
+use axum::extract::State;
+use axum::http::{HeaderMap, StatusCode};
+use axum::response::{IntoResponse, Response};
+use axum::{body::Body, routing::get, Router};
+use camino::{Utf8Path, Utf8PathBuf};
+use fleet_infra::{DownloadRequest, Downloader};
+use std::net::SocketAddr;
+use std::sync::{Arc, Mutex};
+use tempfile::tempdir;
+
+// --- Range-aware test server that records every request it sees ---
+
+#[derive(Clone)]
+struct ServerState {
+    file_bytes: Arc<Vec<u8>>,
+    /// `Some(header)` for a Range request, `None` for a plain GET.
+    requests: Arc<Mutex<Vec<Option<String>>>>,
+    honor_range: bool,
+}
+
+async fn serve_file(State(state): State<ServerState>, headers: HeaderMap) -> Response {
+    let range = headers
+        .get("range")
+        .and_then(|v| v.to_str().ok())
+        .map(str::to_string);
+    state.requests.lock().unwrap().push(range.clone());
+
+    if state.honor_range {
+        if let Some(range) = range {
+            let spec = range.trim_start_matches("bytes=");
+            let start: usize = spec.trim_end_matches('-').parse().unwrap();
+            let slice = state.file_bytes[start..].to_vec();
+            return (StatusCode::PARTIAL_CONTENT, slice).into_response();
+        }
+    }
+
+    Body::from(state.file_bytes.as_ref().clone()).into_response()
+}
+
+async fn start_server(state: ServerState) -> (SocketAddr, tokio::task::JoinHandle<()>) {
+    let app = Router::new()
+        .route("/file.bin", get(serve_file))
+        .with_state(state);
+    let listener = tokio::net::TcpListener::bind("127.0.0.1:0").await.unwrap();
+    let addr = listener.local_addr().unwrap();
+    let handle = tokio::spawn(async move {
+        axum::serve(listener, app).await.unwrap();
+    });
+    (addr, handle)
+}
+
+fn request_for(url: String, target: Utf8PathBuf, content: &[u8]) -> DownloadRequest {
+    // Checksum of the full content, computed the same way verification does.
+    let dir = tempdir().unwrap();
+    let seed = dir.path().join("seed.bin");
+    std::fs::write(&seed, content).unwrap();
+    let checksum = fleet_infra::hashing::compute_file_checksum(
+        Utf8Path::from_path(&seed).unwrap(),
+        Utf8Path::new("file.bin"),
+    )
+    .unwrap();
+
+    DownloadRequest {
+        id: 1,
+        url,
+        mirror_urls: Vec::new(),
+        target_path: target,
+        expected_size: content.len() as u64,
+        expected_checksum: Some(checksum),
+        delta: None,
+    }
+}
+
+#[tokio::test]
+async fn leftover_part_file_is_resumed_with_a_range_request() {
+    let content: Vec<u8> = (0..6_000_000u32).map(|i| (i % 239) as u8).collect();
+    let state = ServerState {
+        file_bytes: Arc::new(content.clone()),
+        requests: Arc::new(Mutex::new(Vec::new())),
+        honor_range: true,
+    };
+    let (addr, handle) = start_server(state.clone()).await;
+
+    let dir = tempdir().unwrap();
+    let root = Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+    let target = root.join("file.bin");
+
+    // A previous run was killed 2 MB in.
+    let resume_at = 2_000_000usize;
+    std::fs::write(target.with_extension("part"), &content[..resume_at]).unwrap();
+
+    let downloader = Downloader::new(reqwest::Client::new(), 1, None);
+    let req = request_for(format!("http://{addr}/file.bin"), target.clone(), &content);
+    let results = downloader.download_batch(vec![req], None).await;
+
+    assert!(results[0].success);
+    assert_eq!(
+        results[0].bytes_downloaded,
+        (content.len() - resume_at) as u64,
+        "only the missing suffix should cross the wire"
+    );
+    assert_eq!(
+        state.requests.lock().unwrap().as_slice(),
+        [Some(format!("bytes={resume_at}-"))]
+    );
+    assert_eq!(std::fs::read(target.as_std_path()).unwrap(), content);
+
+    handle.abort();
+}
+
+#[tokio::test]
+async fn resume_falls_back_to_full_download_when_range_is_ignored() {
+    let content: Vec<u8> = (0..100_000u32).map(|i| (i % 251) as u8).collect();
+    let state = ServerState {
+        file_bytes: Arc::new(content.clone()),
+        requests: Arc::new(Mutex::new(Vec::new())),
+        honor_range: false,
+    };
+    let (addr, handle) = start_server(state.clone()).await;
+
+    let dir = tempdir().unwrap();
+    let root = Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+    let target = root.join("file.bin");
+    std::fs::write(target.with_extension("part"), &content[..40_000]).unwrap();
+
+    let downloader = Downloader::new(reqwest::Client::new(), 1, None);
+    let req = request_for(format!("http://{addr}/file.bin"), target.clone(), &content);
+    let results = downloader.download_batch(vec![req], None).await;
+
+    assert!(results[0].success);
+    assert_eq!(std::fs::read(target.as_std_path()).unwrap(), content);
+
+    handle.abort();
+}
+
+#[tokio::test]
+async fn complete_part_file_is_adopted_without_touching_the_network() {
+    let content: Vec<u8> = (0..50_000u32).map(|i| (i % 241) as u8).collect();
+    let state = ServerState {
+        file_bytes: Arc::new(content.clone()),
+        requests: Arc::new(Mutex::new(Vec::new())),
+        honor_range: true,
+    };
+    let (addr, handle) = start_server(state.clone()).await;
+
+    let dir = tempdir().unwrap();
+    let root = Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+    let target = root.join("file.bin");
+    std::fs::write(target.with_extension("part"), &content).unwrap();
+
+    let downloader = Downloader::new(reqwest::Client::new(), 1, None);
+    let req = request_for(format!("http://{addr}/file.bin"), target.clone(), &content);
+    let results = downloader.download_batch(vec![req], None).await;
+
+    assert!(results[0].success);
+    assert_eq!(results[0].bytes_downloaded, 0);
+    assert!(state.requests.lock().unwrap().is_empty());
+    assert_eq!(std::fs::read(target.as_std_path()).unwrap(), content);
+
+    handle.abort();
+}
@@ -0,0 +1,106 @@
+use camino::Utf8Path;
+use fleet_infra::hashing::{scan_file, StreamingScanner};
+
+// Feed `bytes` to a StreamingScanner in uneven chunks, mimicking how network
+// chunks arrive, and return the streamed checksum.
+fn stream_checksum(logical: &str, bytes: &[u8], chunk_size: usize) -> Option<String> {
+    let mut scanner = StreamingScanner::new(Utf8Path::new(logical));
+    for chunk in bytes.chunks(chunk_size) {
+        scanner.update(chunk);
+    }
+    scanner.finalize()
+}
+
+fn disk_checksum(logical: &str, bytes: &[u8]) -> String {
+    let dir = tempfile::tempdir().unwrap();
+    let path = dir.path().join("file.bin");
+    std::fs::write(&path, bytes).unwrap();
+    let utf = Utf8Path::from_path(&path).unwrap();
+    scan_file(utf, Utf8Path::new(logical)).unwrap().checksum
+}
+
+fn build_pbo(entries: &[(&str, Vec<u8>)], trailing: &[u8]) -> Vec<u8> {
+    let mut out = Vec::new();
+    for (name, data) in entries {
+        out.extend_from_slice(name.as_bytes());
+        out.push(0);
+        out.extend_from_slice(&0u32.to_le_bytes()); // type
+        out.extend_from_slice(&(data.len() as u32).to_le_bytes()); // original_size
+        out.extend_from_slice(&0u32.to_le_bytes()); // offset
+        out.extend_from_slice(&0u32.to_le_bytes()); // timestamp
+        out.extend_from_slice(&(data.len() as u32).to_le_bytes()); // data_size
+    }
+    out.push(0);
+    out.extend_from_slice(&[0u8; 20]);
+    for (_, data) in entries {
+        out.extend_from_slice(data);
+    }
+    out.extend_from_slice(trailing);
+    out
+}
+
+#[test]
+fn raw_streaming_matches_disk_scan_across_part_boundaries() {
+    // Larger than one 5,000,000-byte part so the part split is exercised.
+    let data: Vec<u8> = (0..11_000_000u32).map(|i| (i % 251) as u8).collect();
+    let expected = disk_checksum("terrain.wrp", &data);
+
+    for chunk_size in [8 * 1024, 1_000_000, 4_999_999] {
+        assert_eq!(
+            stream_checksum("terrain.wrp", &data, chunk_size).as_deref(),
+            Some(expected.as_str()),
+            "chunk size {chunk_size}"
+        );
+    }
+}
+
+#[test]
+fn raw_parallel_part_hashing_matches_streaming() {
+    // Past the 64 MB threshold the disk scan hashes parts on the rayon pool;
+    // the (sequential) streaming scanner cross-checks the result.
+    let data: Vec<u8> = (0..70_000_000u32).map(|i| (i % 249) as u8).collect();
+    let expected = disk_checksum("terrain.wrp", &data);
+    assert_eq!(
+        stream_checksum("terrain.wrp", &data, 1_000_000).as_deref(),
+        Some(expected.as_str())
+    );
+}
+
+#[test]
+fn raw_streaming_matches_disk_scan_for_small_and_empty_files() {
+    for data in [b"hello".to_vec(), Vec::new()] {
+        let expected = disk_checksum("readme.txt", &data);
+        assert_eq!(
+            stream_checksum("readme.txt", &data, 3).as_deref(),
+            Some(expected.as_str())
+        );
+    }
+}
+
+#[test]
+fn pbo_streaming_matches_disk_scan() {
+    let pbo = build_pbo(
+        &[
+            ("config.bin", vec![1u8; 3000]),
+            ("empty.bin", Vec::new()),
+            ("model.p3d", vec![2u8; 5000]),
+        ],
+        b"SIGNATURE",
+    );
+    let expected = disk_checksum("addons/pack.pbo", &pbo);
+
+    for chunk_size in [1, 7, 512, 100_000] {
+        assert_eq!(
+            stream_checksum("addons/pack.pbo", &pbo, chunk_size).as_deref(),
+            Some(expected.as_str()),
+            "chunk size {chunk_size}"
+        );
+    }
+}
+
+#[test]
+fn truncated_pbo_stream_reports_no_checksum() {
+    let pbo = build_pbo(&[("config.bin", vec![1u8; 3000])], b"");
+    let truncated = &pbo[..pbo.len() - 100];
+    assert_eq!(stream_checksum("addons/pack.pbo", truncated, 512), None);
+}
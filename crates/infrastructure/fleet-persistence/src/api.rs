@@ -34,6 +34,24 @@ pub struct FileCacheEntry {
     pub mtime: u64,
     pub size: u64,
     pub checksum: String,
+    /// Fast local-verification digest; empty for entries written before the
+    /// fast hash track existed.
+    #[serde(default)]
+    pub fast_checksum: String,
+}
+
+/// Fully resolved launch command cached per profile so a warm `fleet launch`
+/// is a single read plus spawn instead of a directory walk and template
+/// resolve. `dir_mtime` is the mod root's directory mtime at resolve time;
+/// `config_fingerprint` covers the launch args/template the command was built
+/// from — either changing invalidates the entry.
+#[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
+pub struct LaunchCacheEntry {
+    pub dir_mtime: u64,
+    pub config_fingerprint: String,
+    pub program: String,
+    pub args: Vec<String>,
+    pub working_dir: String,
 }
 
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
@@ -42,6 +60,8 @@ pub struct CacheUpsert {
     pub mtime: u64,
     pub size: u64,
     pub checksum: String,
+    #[serde(default)]
+    pub fast_checksum: String,
 }
 
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
@@ -51,6 +71,8 @@ pub struct CacheUpsertRecord {
     pub mtime: u64,
     pub size: u64,
     pub checksum: String,
+    #[serde(default)]
+    pub fast_checksum: String,
 }
 
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
@@ -112,6 +134,19 @@ pub trait FleetDataStore: Send + Sync {
         new_rel_path: &str,
     ) -> Result<(), crate::StorageError>;
 
+    fn load_launch_command(
+        &self,
+        root: &Utf8Path,
+        profile_id: &str,
+    ) -> Result<Option<LaunchCacheEntry>, crate::StorageError>;
+
+    fn store_launch_command(
+        &self,
+        root: &Utf8Path,
+        profile_id: &str,
+        entry: &LaunchCacheEntry,
+    ) -> Result<(), crate::StorageError>;
+
     fn commit_repair_snapshot(
         &self,
         root: &Utf8Path,
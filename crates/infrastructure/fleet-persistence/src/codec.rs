@@ -1,20 +1,232 @@
-use crate::api::{FileCacheEntry, LocalManifestSummary};
+use crate::api::{FileCacheEntry, LaunchCacheEntry, LocalFileSummary, LocalManifestSummary};
 use crate::StorageError;
 
+// Baseline blobs use a compact column-oriented binary layout so that loading
+// a large manifest is a bulk decode instead of a serde_json tree walk. Each
+// blob starts with a magic tag; payloads without one are decoded as the JSON
+// written by older versions, so existing databases migrate on their next
+// snapshot commit.
+const MANIFEST_MAGIC: &[u8; 4] = b"FBM1";
+const SUMMARY_MAGIC: &[u8; 4] = b"FBS1";
+
 pub fn encode_manifest(manifest: &fleet_core::Manifest) -> Result<Vec<u8>, StorageError> {
-    Ok(serde_json::to_vec(manifest)?)
+    let mut w = Writer::new(MANIFEST_MAGIC);
+    w.str16(&manifest.version)?;
+    w.u32(len_u32(manifest.mods.len())?);
+    for m in &manifest.mods {
+        w.str16(&m.name)?;
+        w.str16(&m.checksum)?;
+        w.u32(len_u32(m.files.len())?);
+
+        // File columns: prefix-deduplicated paths, then fixed-width lengths,
+        // checksums, types, and per-file part counts.
+        let mut prev_path = "";
+        for f in &m.files {
+            w.prefixed_str(prev_path, &f.path)?;
+            prev_path = &f.path;
+        }
+        for f in &m.files {
+            w.u64(f.length);
+        }
+        for f in &m.files {
+            w.str16(&f.checksum)?;
+        }
+        for f in &m.files {
+            w.u8(match f.file_type {
+                fleet_core::FileType::File => 0,
+                fleet_core::FileType::Pbo => 1,
+            });
+        }
+        for f in &m.files {
+            w.u32(len_u32(f.parts.len())?);
+        }
+
+        // Flat part side table, in file order.
+        let mut prev_part = "";
+        for f in &m.files {
+            for p in &f.parts {
+                w.prefixed_str(prev_part, &p.path)?;
+                prev_part = &p.path;
+            }
+        }
+        for f in &m.files {
+            for p in &f.parts {
+                w.u64(p.length);
+            }
+        }
+        for f in &m.files {
+            for p in &f.parts {
+                w.u64(p.start);
+            }
+        }
+        for f in &m.files {
+            for p in &f.parts {
+                w.str16(&p.checksum)?;
+            }
+        }
+    }
+    Ok(w.into_bytes())
 }
 
 pub fn decode_manifest(bytes: &[u8]) -> Result<fleet_core::Manifest, StorageError> {
-    Ok(serde_json::from_slice(bytes)?)
+    let Some(mut r) = Reader::with_magic(bytes, MANIFEST_MAGIC) else {
+        return Ok(serde_json::from_slice(bytes)?);
+    };
+
+    let version = r.str16()?.to_string();
+    let mod_count = r.u32()? as usize;
+    let mut mods = Vec::with_capacity(mod_count);
+    for _ in 0..mod_count {
+        let name = r.str16()?.to_string();
+        let checksum = r.str16()?.to_string();
+        let file_count = r.u32()? as usize;
+
+        let mut paths = Vec::with_capacity(file_count);
+        let mut prev_path = String::new();
+        for _ in 0..file_count {
+            prev_path = r.prefixed_str(&prev_path)?;
+            paths.push(prev_path.clone());
+        }
+        let mut lengths = Vec::with_capacity(file_count);
+        for _ in 0..file_count {
+            lengths.push(r.u64()?);
+        }
+        let mut checksums = Vec::with_capacity(file_count);
+        for _ in 0..file_count {
+            checksums.push(r.str16()?.to_string());
+        }
+        let mut types = Vec::with_capacity(file_count);
+        for _ in 0..file_count {
+            types.push(match r.u8()? {
+                0 => fleet_core::FileType::File,
+                1 => fleet_core::FileType::Pbo,
+                _ => return Err(StorageError::Corrupt),
+            });
+        }
+        let mut part_counts = Vec::with_capacity(file_count);
+        for _ in 0..file_count {
+            part_counts.push(r.u32()? as usize);
+        }
+
+        let total_parts: usize = part_counts.iter().sum();
+        let mut part_paths = Vec::with_capacity(total_parts);
+        let mut prev_part = String::new();
+        for _ in 0..total_parts {
+            prev_part = r.prefixed_str(&prev_part)?;
+            part_paths.push(prev_part.clone());
+        }
+        let mut part_lengths = Vec::with_capacity(total_parts);
+        for _ in 0..total_parts {
+            part_lengths.push(r.u64()?);
+        }
+        let mut part_starts = Vec::with_capacity(total_parts);
+        for _ in 0..total_parts {
+            part_starts.push(r.u64()?);
+        }
+        let mut part_checksums = Vec::with_capacity(total_parts);
+        for _ in 0..total_parts {
+            part_checksums.push(r.str16()?.to_string());
+        }
+
+        let mut part_paths = part_paths.into_iter();
+        let mut part_lengths = part_lengths.into_iter();
+        let mut part_starts = part_starts.into_iter();
+        let mut part_checksums = part_checksums.into_iter();
+
+        let mut files = Vec::with_capacity(file_count);
+        for i in 0..file_count {
+            let mut parts = Vec::with_capacity(part_counts[i]);
+            for _ in 0..part_counts[i] {
+                parts.push(fleet_core::FilePart {
+                    path: part_paths.next().ok_or(StorageError::Corrupt)?,
+                    length: part_lengths.next().ok_or(StorageError::Corrupt)?,
+                    start: part_starts.next().ok_or(StorageError::Corrupt)?,
+                    checksum: part_checksums.next().ok_or(StorageError::Corrupt)?,
+                });
+            }
+            files.push(fleet_core::File {
+                path: std::mem::take(&mut paths[i]),
+                length: lengths[i],
+                checksum: std::mem::take(&mut checksums[i]),
+                file_type: types[i].clone(),
+                parts,
+                canonical: Default::default(),
+            });
+        }
+
+        mods.push(fleet_core::Mod {
+            name,
+            checksum,
+            files,
+        });
+    }
+    r.finish()?;
+    Ok(fleet_core::Manifest { version, mods })
 }
 
 pub fn encode_summary(summary: &[LocalManifestSummary]) -> Result<Vec<u8>, StorageError> {
-    Ok(serde_json::to_vec(summary)?)
+    let mut w = Writer::new(SUMMARY_MAGIC);
+    w.u32(len_u32(summary.len())?);
+    for m in summary {
+        w.str16(&m.mod_name)?;
+        w.u32(len_u32(m.files.len())?);
+        let mut prev_path = "";
+        for f in &m.files {
+            w.prefixed_str(prev_path, &f.rel_path)?;
+            prev_path = &f.rel_path;
+        }
+        for f in &m.files {
+            w.u64(f.mtime);
+        }
+        for f in &m.files {
+            w.u64(f.size);
+        }
+        for f in &m.files {
+            w.str16(&f.checksum)?;
+        }
+    }
+    Ok(w.into_bytes())
 }
 
 pub fn decode_summary(bytes: &[u8]) -> Result<Vec<LocalManifestSummary>, StorageError> {
-    Ok(serde_json::from_slice(bytes)?)
+    let Some(mut r) = Reader::with_magic(bytes, SUMMARY_MAGIC) else {
+        return Ok(serde_json::from_slice(bytes)?);
+    };
+
+    let mod_count = r.u32()? as usize;
+    let mut out = Vec::with_capacity(mod_count);
+    for _ in 0..mod_count {
+        let mod_name = r.str16()?.to_string();
+        let file_count = r.u32()? as usize;
+
+        let mut rel_paths = Vec::with_capacity(file_count);
+        let mut prev_path = String::new();
+        for _ in 0..file_count {
+            prev_path = r.prefixed_str(&prev_path)?;
+            rel_paths.push(prev_path.clone());
+        }
+        let mut mtimes = Vec::with_capacity(file_count);
+        for _ in 0..file_count {
+            mtimes.push(r.u64()?);
+        }
+        let mut sizes = Vec::with_capacity(file_count);
+        for _ in 0..file_count {
+            sizes.push(r.u64()?);
+        }
+
+        let mut files = Vec::with_capacity(file_count);
+        for (i, rel_path) in rel_paths.into_iter().enumerate() {
+            files.push(LocalFileSummary {
+                rel_path,
+                mtime: mtimes[i],
+                size: sizes[i],
+                checksum: r.str16()?.to_string(),
+            });
+        }
+        out.push(LocalManifestSummary { mod_name, files });
+    }
+    r.finish()?;
+    Ok(out)
 }
 
 pub fn encode_cache_entry(entry: &FileCacheEntry) -> Result<Vec<u8>, StorageError> {
@@ -24,3 +236,232 @@ pub fn encode_cache_entry(entry: &FileCacheEntry) -> Result<Vec<u8>, StorageErro
 pub fn decode_cache_entry(bytes: &[u8]) -> Result<FileCacheEntry, StorageError> {
     Ok(serde_json::from_slice(bytes)?)
 }
+
+pub fn encode_launch_entry(entry: &LaunchCacheEntry) -> Result<Vec<u8>, StorageError> {
+    Ok(serde_json::to_vec(entry)?)
+}
+
+pub fn decode_launch_entry(bytes: &[u8]) -> Result<LaunchCacheEntry, StorageError> {
+    Ok(serde_json::from_slice(bytes)?)
+}
+
+fn len_u32(len: usize) -> Result<u32, StorageError> {
+    u32::try_from(len).map_err(|_| StorageError::Corrupt)
+}
+
+fn len_u16(len: usize) -> Result<u16, StorageError> {
+    u16::try_from(len).map_err(|_| StorageError::Corrupt)
+}
+
+struct Writer {
+    buf: Vec<u8>,
+}
+
+impl Writer {
+    fn new(magic: &[u8; 4]) -> Self {
+        let mut buf = Vec::with_capacity(64 * 1024);
+        buf.extend_from_slice(magic);
+        Self { buf }
+    }
+
+    fn into_bytes(self) -> Vec<u8> {
+        self.buf
+    }
+
+    fn u8(&mut self, v: u8) {
+        self.buf.push(v);
+    }
+
+    fn u16(&mut self, v: u16) {
+        self.buf.extend_from_slice(&v.to_le_bytes());
+    }
+
+    fn u32(&mut self, v: u32) {
+        self.buf.extend_from_slice(&v.to_le_bytes());
+    }
+
+    fn u64(&mut self, v: u64) {
+        self.buf.extend_from_slice(&v.to_le_bytes());
+    }
+
+    fn str16(&mut self, s: &str) -> Result<(), StorageError> {
+        self.u16(len_u16(s.len())?);
+        self.buf.extend_from_slice(s.as_bytes());
+        Ok(())
+    }
+
+    /// Writes `s` as (shared-prefix length with `prev`, suffix). Consecutive
+    /// paths share long directory prefixes, so this collapses most of the
+    /// path bytes in a sorted manifest.
+    fn prefixed_str(&mut self, prev: &str, s: &str) -> Result<(), StorageError> {
+        let shared = prev
+            .as_bytes()
+            .iter()
+            .zip(s.as_bytes())
+            .take_while(|(a, b)| a == b)
+            .count()
+            .min(u16::MAX as usize);
+        // Never split a UTF-8 code point.
+        let shared = (0..=shared)
+            .rev()
+            .find(|&n| s.is_char_boundary(n))
+            .unwrap_or(0);
+        self.u16(shared as u16);
+        self.str16(&s[shared..])
+    }
+}
+
+struct Reader<'a> {
+    rest: &'a [u8],
+}
+
+impl<'a> Reader<'a> {
+    fn with_magic(bytes: &'a [u8], magic: &[u8; 4]) -> Option<Self> {
+        bytes.strip_prefix(magic.as_slice()).map(|rest| Self { rest })
+    }
+
+    fn take(&mut self, n: usize) -> Result<&'a [u8], StorageError> {
+        if self.rest.len() < n {
+            return Err(StorageError::Corrupt);
+        }
+        let (head, tail) = self.rest.split_at(n);
+        self.rest = tail;
+        Ok(head)
+    }
+
+    fn u8(&mut self) -> Result<u8, StorageError> {
+        Ok(self.take(1)?[0])
+    }
+
+    fn u16(&mut self) -> Result<u16, StorageError> {
+        Ok(u16::from_le_bytes(self.take(2)?.try_into().unwrap()))
+    }
+
+    fn u32(&mut self) -> Result<u32, StorageError> {
+        Ok(u32::from_le_bytes(self.take(4)?.try_into().unwrap()))
+    }
+
+    fn u64(&mut self) -> Result<u64, StorageError> {
+        Ok(u64::from_le_bytes(self.take(8)?.try_into().unwrap()))
+    }
+
+    fn str16(&mut self) -> Result<&'a str, StorageError> {
+        let len = self.u16()? as usize;
+        std::str::from_utf8(self.take(len)?).map_err(|_| StorageError::Corrupt)
+    }
+
+    fn prefixed_str(&mut self, prev: &str) -> Result<String, StorageError> {
+        let shared = self.u16()? as usize;
+        let prefix = prev.get(..shared).ok_or(StorageError::Corrupt)?;
+        let suffix = self.str16()?;
+        let mut out = String::with_capacity(prefix.len() + suffix.len());
+        out.push_str(prefix);
+        out.push_str(suffix);
+        Ok(out)
+    }
+
+    fn finish(self) -> Result<(), StorageError> {
+        if self.rest.is_empty() {
+            Ok(())
+        } else {
+            Err(StorageError::Corrupt)
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn sample_manifest() -> fleet_core::Manifest {
+        fleet_core::Manifest {
+            version: "1.0".into(),
+            mods: vec![fleet_core::Mod {
+                name: "@mod".into(),
+                checksum: "MODSUM".into(),
+                files: vec![
+                    fleet_core::File {
+                        path: "addons/alpha.pbo".into(),
+                        length: 10_000_000,
+                        checksum: "AAAA".into(),
+                        file_type: fleet_core::FileType::Pbo,
+                        parts: vec![
+                            fleet_core::FilePart {
+                                path: "$HEADER$".into(),
+                                length: 1234,
+                                start: 0,
+                                checksum: "HHHH".into(),
+                            },
+                            fleet_core::FilePart {
+                                path: "data/tex.paa".into(),
+                                length: 9_998_766,
+                                start: 1234,
+                                checksum: "TTTT".into(),
+                            },
+                        ],
+                        canonical: Default::default(),
+                    },
+                    fleet_core::File {
+                        path: "addons/beta.pbo".into(),
+                        length: 0,
+                        checksum: "BBBB".into(),
+                        file_type: fleet_core::FileType::File,
+                        parts: vec![],
+                        canonical: Default::default(),
+                    },
+                ],
+            }],
+        }
+    }
+
+    #[test]
+    fn manifest_binary_roundtrip() {
+        let manifest = sample_manifest();
+        let bytes = encode_manifest(&manifest).unwrap();
+        assert_eq!(&bytes[..4], MANIFEST_MAGIC);
+        let decoded = decode_manifest(&bytes).unwrap();
+        assert_eq!(decoded, manifest);
+    }
+
+    #[test]
+    fn manifest_json_blob_still_decodes() {
+        let manifest = sample_manifest();
+        let json = serde_json::to_vec(&manifest).unwrap();
+        let decoded = decode_manifest(&json).unwrap();
+        assert_eq!(decoded, manifest);
+    }
+
+    #[test]
+    fn summary_binary_roundtrip() {
+        let summary = vec![LocalManifestSummary {
+            mod_name: "@mod".into(),
+            files: vec![
+                LocalFileSummary {
+                    rel_path: "addons/alpha.pbo".into(),
+                    mtime: 1_700_000_000,
+                    size: 10_000_000,
+                    checksum: "AAAA".into(),
+                },
+                LocalFileSummary {
+                    rel_path: "addons/beta.pbo".into(),
+                    mtime: 1_700_000_100,
+                    size: 0,
+                    checksum: "BBBB".into(),
+                },
+            ],
+        }];
+        let bytes = encode_summary(&summary).unwrap();
+        assert_eq!(&bytes[..4], SUMMARY_MAGIC);
+        assert_eq!(decode_summary(&bytes).unwrap(), summary);
+
+        let json = serde_json::to_vec(&summary).unwrap();
+        assert_eq!(decode_summary(&json).unwrap(), summary);
+    }
+
+    #[test]
+    fn truncated_binary_blob_is_corrupt() {
+        let bytes = encode_manifest(&sample_manifest()).unwrap();
+        let err = decode_manifest(&bytes[..bytes.len() - 1]).unwrap_err();
+        assert!(matches!(err, StorageError::Corrupt));
+    }
+}
@@ -5,7 +5,9 @@ mod error;
 mod maintenance;
 mod paths;
 mod redb_store;
+mod write_behind;
 
 pub use api::*;
 pub use error::*;
 pub use redb_store::RedbFleetDataStore;
+pub use write_behind::CacheWriteBehind;
@@ -11,8 +11,8 @@ use crate::api::{
 };
 use crate::cache_key::CacheKey;
 use crate::codec::{
-    decode_cache_entry, decode_manifest, decode_summary, encode_cache_entry, encode_manifest,
-    encode_summary,
+    decode_cache_entry, decode_launch_entry, decode_manifest, decode_summary, encode_cache_entry,
+    encode_launch_entry, encode_manifest, encode_summary,
 };
 use crate::maintenance::quarantine_corrupt_file;
 use crate::paths::normalize_rel_path;
@@ -21,6 +21,7 @@ use crate::{FleetDataStore, StorageError};
 const META: TableDefinition<&str, &str> = TableDefinition::new("meta");
 const BASELINE: TableDefinition<&str, &[u8]> = TableDefinition::new("baseline");
 const SCAN_CACHE: TableDefinition<&[u8], &[u8]> = TableDefinition::new("scan_cache");
+const LAUNCH_CACHE: TableDefinition<&str, &[u8]> = TableDefinition::new("launch_cache");
 
 const META_FORMAT_KEY: &str = "format";
 const META_FORMAT_VALUE: &str = "fleet-redb";
@@ -166,6 +167,7 @@ impl RedbFleetDataStore {
         // Open tables (creates if missing)
         let _ = write_tx.open_table(BASELINE)?;
         let _ = write_tx.open_table(SCAN_CACHE)?;
+        let _ = write_tx.open_table(LAUNCH_CACHE)?;
         write_tx.commit()?;
 
         // Validate schema version.
@@ -374,6 +376,7 @@ impl FleetDataStore for RedbFleetDataStore {
                     mtime: e.mtime,
                     size: e.size,
                     checksum: e.checksum.clone(),
+                    fast_checksum: e.fast_checksum.clone(),
                 })?;
                 table.insert(key.as_slice(), value.as_slice())?;
             }
@@ -455,6 +458,45 @@ impl FleetDataStore for RedbFleetDataStore {
         Ok(())
     }
 
+    fn load_launch_command(
+        &self,
+        root: &Utf8Path,
+        profile_id: &str,
+    ) -> Result<Option<crate::api::LaunchCacheEntry>, StorageError> {
+        let path = Self::path_for_root(root);
+        if !path.exists() {
+            return Ok(None);
+        }
+        let db = match self.open_existing(root) {
+            Ok(db) => db,
+            Err(StorageError::Missing) => return Ok(None),
+            Err(e) => return Err(e),
+        };
+        let read_tx = db.begin_read()?;
+        let table = read_tx.open_table(LAUNCH_CACHE)?;
+        match table.get(profile_id)? {
+            Some(guard) => Ok(Some(decode_launch_entry(guard.value())?)),
+            None => Ok(None),
+        }
+    }
+
+    fn store_launch_command(
+        &self,
+        root: &Utf8Path,
+        profile_id: &str,
+        entry: &crate::api::LaunchCacheEntry,
+    ) -> Result<(), StorageError> {
+        let db = self.open_or_create(root)?;
+        let value = encode_launch_entry(entry)?;
+        let write_tx = db.begin_write()?;
+        {
+            let mut table = write_tx.open_table(LAUNCH_CACHE)?;
+            table.insert(profile_id, value.as_slice())?;
+        }
+        write_tx.commit()?;
+        Ok(())
+    }
+
     fn commit_repair_snapshot(
         &self,
         root: &Utf8Path,
@@ -555,6 +597,7 @@ impl FleetDataStore for RedbFleetDataStore {
                     mtime: up.mtime,
                     size: up.size,
                     checksum: up.checksum.clone(),
+                    fast_checksum: up.fast_checksum.clone(),
                 })?;
                 cache.insert(key.as_slice(), value.as_slice())?;
             }
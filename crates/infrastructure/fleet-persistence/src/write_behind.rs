@@ -0,0 +1,108 @@
+use std::collections::HashMap;
+use std::sync::mpsc;
+use std::sync::Arc;
+
+use camino::Utf8PathBuf;
+
+use crate::api::{CacheUpsert, CacheUpsertRecord};
+use crate::{FleetDataStore, StorageError};
+
+/// Records per flush transaction. Large enough to amortize the commit,
+/// small enough that a flush never stalls the writer thread for long.
+const FLUSH_BATCH: usize = 512;
+
+/// Write-behind buffer for scan-cache upserts.
+///
+/// Verified downloads used to accumulate into one large transaction committed
+/// at the end of the sync, which stalls for seconds on spinning disks.
+/// `CacheWriteBehind` accepts records as files verify and flushes them in
+/// bounded batches on a background thread while the sync is still
+/// downloading, so the end-of-sync commit only has to seal the baseline.
+pub struct CacheWriteBehind {
+    tx: Option<mpsc::Sender<CacheUpsertRecord>>,
+    handle: Option<std::thread::JoinHandle<Result<(), StorageError>>>,
+}
+
+impl CacheWriteBehind {
+    pub fn spawn(store: Arc<dyn FleetDataStore>, root: Utf8PathBuf) -> Self {
+        let (tx, rx) = mpsc::channel::<CacheUpsertRecord>();
+        let handle = std::thread::spawn(move || {
+            let mut pending: HashMap<String, Vec<CacheUpsert>> = HashMap::new();
+            let mut pending_len = 0usize;
+            while let Ok(record) = rx.recv() {
+                buffer(&mut pending, record);
+                pending_len += 1;
+                // Drain whatever else is already queued without blocking.
+                while pending_len < FLUSH_BATCH {
+                    match rx.try_recv() {
+                        Ok(record) => {
+                            buffer(&mut pending, record);
+                            pending_len += 1;
+                        }
+                        Err(_) => break,
+                    }
+                }
+                if pending_len >= FLUSH_BATCH {
+                    flush(store.as_ref(), &root, &mut pending)?;
+                    pending_len = 0;
+                }
+            }
+            flush(store.as_ref(), &root, &mut pending)
+        });
+        Self {
+            tx: Some(tx),
+            handle: Some(handle),
+        }
+    }
+
+    /// Queues one verified file for persistence. Never blocks on the database.
+    pub fn record(&self, record: CacheUpsertRecord) {
+        if let Some(tx) = &self.tx {
+            // A send error means the writer thread already failed; the error
+            // surfaces from `seal`.
+            let _ = tx.send(record);
+        }
+    }
+
+    /// Flushes everything still buffered and stops the background thread,
+    /// surfacing the first persistence error if any flush failed.
+    pub fn seal(mut self) -> Result<(), StorageError> {
+        drop(self.tx.take());
+        match self.handle.take().expect("sealed twice").join() {
+            Ok(result) => result,
+            Err(_) => Err(StorageError::Io(std::io::Error::other(
+                "cache write-behind thread panicked",
+            ))),
+        }
+    }
+}
+
+impl Drop for CacheWriteBehind {
+    fn drop(&mut self) {
+        // Unsealed (e.g. the sync errored out): let the thread drain and
+        // flush what it has. The records describe verified on-disk files, so
+        // persisting them is correct even for an aborted sync.
+        drop(self.tx.take());
+    }
+}
+
+fn buffer(pending: &mut HashMap<String, Vec<CacheUpsert>>, record: CacheUpsertRecord) {
+    pending.entry(record.mod_name).or_default().push(CacheUpsert {
+        rel_path: record.rel_path,
+        mtime: record.mtime,
+        size: record.size,
+        checksum: record.checksum,
+        fast_checksum: record.fast_checksum,
+    });
+}
+
+fn flush(
+    store: &dyn FleetDataStore,
+    root: &Utf8PathBuf,
+    pending: &mut HashMap<String, Vec<CacheUpsert>>,
+) -> Result<(), StorageError> {
+    for (mod_name, entries) in pending.drain() {
+        store.scan_cache_upsert_batch(root, &mod_name, &entries)?;
+    }
+    Ok(())
+}
@@ -28,12 +28,14 @@ fn delete_mod_only_removes_that_mods_entries() {
                     mtime: 1,
                     size: 1,
                     checksum: "a1".into(),
+                    fast_checksum: String::new(),
                 },
                 CacheUpsert {
                     rel_path: "a2.txt".into(),
                     mtime: 2,
                     size: 2,
                     checksum: "a2".into(),
+                    fast_checksum: String::new(),
                 },
             ],
         )
@@ -48,6 +50,7 @@ fn delete_mod_only_removes_that_mods_entries() {
                 mtime: 3,
                 size: 3,
                 checksum: "b".into(),
+                fast_checksum: String::new(),
             }],
         )
         .unwrap();
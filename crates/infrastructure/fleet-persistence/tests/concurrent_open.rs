@@ -40,6 +40,7 @@ fn concurrent_cache_access_does_not_error_database_already_open() {
                             mtime: 1,
                             size: 1,
                             checksum: "abc".into(),
+                            fast_checksum: String::new(),
                         }],
                     )
                     .unwrap();
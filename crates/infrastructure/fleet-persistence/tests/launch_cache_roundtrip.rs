@@ -0,0 +1,42 @@
+use camino::Utf8PathBuf;
+use fleet_persistence::{FleetDataStore, LaunchCacheEntry, RedbFleetDataStore};
+
+#[test]
+fn launch_command_roundtrips_per_profile() {
+    let dir = tempfile::tempdir().unwrap();
+    let root = Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+
+    let store = RedbFleetDataStore;
+    assert_eq!(store.load_launch_command(&root, "main").unwrap(), None);
+
+    let entry = LaunchCacheEntry {
+        dir_mtime: 1_700_000_000_000,
+        config_fingerprint: "-noSplash\nsteam -applaunch 107410 $ARGS $MODS".into(),
+        program: "steam".into(),
+        args: vec![
+            "-applaunch".into(),
+            "107410".into(),
+            "-mod=Z:\\mods\\@ace;".into(),
+        ],
+        working_dir: ".".into(),
+    };
+    store.store_launch_command(&root, "main", &entry).unwrap();
+
+    assert_eq!(
+        store.load_launch_command(&root, "main").unwrap(),
+        Some(entry.clone())
+    );
+    // Other profiles keep their own slot.
+    assert_eq!(store.load_launch_command(&root, "other").unwrap(), None);
+
+    // Re-storing overwrites in place.
+    let updated = LaunchCacheEntry {
+        dir_mtime: entry.dir_mtime + 1,
+        ..entry
+    };
+    store.store_launch_command(&root, "main", &updated).unwrap();
+    assert_eq!(
+        store.load_launch_command(&root, "main").unwrap(),
+        Some(updated)
+    );
+}
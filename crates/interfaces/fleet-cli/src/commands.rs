@@ -42,24 +42,85 @@ pub async fn cmd_scan(
     };
 
     let root = path.clone();
-    let manifest = tokio::task::spawn_blocking(move || {
-        Scanner::scan_directory(root.as_path(), strategy, Some(cb), None, None)
-    })
-    .await??;
-
-    pb.finish_with_message("Scan complete.");
-
-    let json = serde_json::to_string_pretty(&manifest)?;
     if let Some(out) = output {
-        std::fs::write(&out, json)?;
+        // Streaming path: each mod is serialized the moment its last file
+        // finishes hashing and then dropped, so peak memory is one mod and
+        // serialization overlaps hashing instead of stalling at the end.
+        let out_clone = out.clone();
+        tokio::task::spawn_blocking(move || -> Result<()> {
+            let writer = std::sync::Mutex::new(ManifestStreamWriter::create(&out_clone)?);
+            Scanner::scan_directory_sink(root.as_path(), strategy, Some(cb), None, None, |m| {
+                writer.lock().unwrap().write_mod(m);
+            })?;
+            writer.into_inner().unwrap().finish()
+        })
+        .await??;
+        pb.finish_with_message("Scan complete.");
         println!(":: Saved manifest to {}", out);
     } else {
-        println!("{}", json);
+        let manifest = tokio::task::spawn_blocking(move || {
+            Scanner::scan_directory(root.as_path(), strategy, Some(cb), None, None)
+        })
+        .await??;
+        pb.finish_with_message("Scan complete.");
+        println!("{}", serde_json::to_string_pretty(&manifest)?);
     }
 
     Ok(())
 }
 
+/// Incremental `Manifest` JSON writer: emits the envelope up front and each
+/// mod as it arrives. Write errors are latched and surfaced by `finish`,
+/// since the per-mod callback runs on scan workers that cannot bail out.
+struct ManifestStreamWriter {
+    out: std::io::BufWriter<std::fs::File>,
+    mods_written: u64,
+    error: Option<anyhow::Error>,
+}
+
+impl ManifestStreamWriter {
+    fn create(path: &Utf8PathBuf) -> Result<Self> {
+        use std::io::Write;
+        let file = std::fs::File::create(path)
+            .with_context(|| format!("Failed to create {}", path))?;
+        let mut out = std::io::BufWriter::new(file);
+        out.write_all(br#"{"Version":"1.0","Mods":["#)?;
+        Ok(Self {
+            out,
+            mods_written: 0,
+            error: None,
+        })
+    }
+
+    fn write_mod(&mut self, m: &fleet_core::Mod) {
+        use std::io::Write;
+        if self.error.is_some() {
+            return;
+        }
+        let res = (|| -> Result<()> {
+            if self.mods_written > 0 {
+                self.out.write_all(b",")?;
+            }
+            serde_json::to_writer(&mut self.out, m)?;
+            Ok(())
+        })();
+        match res {
+            Ok(()) => self.mods_written += 1,
+            Err(e) => self.error = Some(e),
+        }
+    }
+
+    fn finish(mut self) -> Result<()> {
+        use std::io::Write;
+        if let Some(e) = self.error.take() {
+            return Err(e.context("Failed writing manifest output"));
+        }
+        self.out.write_all(b"]}")?;
+        self.out.flush()?;
+        Ok(())
+    }
+}
+
 pub async fn cmd_check(
     repo: String,
     local_path: Utf8PathBuf,
@@ -133,7 +194,7 @@ pub async fn cmd_check_for_updates(repo: String, local_path: Utf8PathBuf) -> any
     Ok(())
 }
 
-pub async fn cmd_local_check(local_path: Utf8PathBuf) -> anyhow::Result<()> {
+pub async fn cmd_local_check(local_path: Utf8PathBuf, watch: bool) -> anyhow::Result<()> {
     println!(":: Local integrity check...");
     println!("   Local: {}", local_path);
 
@@ -152,7 +213,13 @@ pub async fn cmd_local_check(local_path: Utf8PathBuf) -> anyhow::Result<()> {
     }
 
     let client = fleet_infra::net::default_http_client().context("Failed to build HTTP client")?;
-    let engine = fleet_pipeline::default_engine(client);
+    // Watch mode keeps the engine alive, so the watcher-backed provider can
+    // answer repeat checks by re-scanning only what changed on disk.
+    let engine = if watch {
+        fleet_pipeline::watched_engine(client)
+    } else {
+        fleet_pipeline::default_engine(client)
+    };
 
     let req = SyncRequest {
         repo_url: String::new(),
@@ -196,7 +263,33 @@ pub async fn cmd_local_check(local_path: Utf8PathBuf) -> anyhow::Result<()> {
         println!("   Status:          Dirty (run `sync` or investigate)");
     }
 
-    Ok(())
+    if !watch {
+        return Ok(());
+    }
+
+    println!("\n:: Watching for changes (Ctrl+C to stop)...");
+    let mut last = (plan.downloads.len(), plan.deletes.len());
+    loop {
+        tokio::time::sleep(Duration::from_secs(2)).await;
+
+        let local_state = engine.scan_local_state(&req, None).await?;
+        let plan = engine.compute_local_integrity_plan(&req, &local_state)?;
+        let current = (plan.downloads.len(), plan.deletes.len());
+        if current == last {
+            continue;
+        }
+        last = current;
+
+        if plan.downloads.is_empty() && plan.deletes.is_empty() {
+            println!("   Clean");
+        } else {
+            println!(
+                "   Dirty: {} missing/changed, {} extra",
+                plan.downloads.len(),
+                plan.deletes.len()
+            );
+        }
+    }
 }
 
 pub async fn cmd_repair(repo: String, local_path: Utf8PathBuf) -> anyhow::Result<()> {
@@ -255,6 +348,8 @@ pub async fn cmd_sync(
     threads: usize,
     limit_mb: Option<u64>,
     cache_dir: Option<Utf8PathBuf>,
+    perf_report: bool,
+    dedup_roots: Vec<Utf8PathBuf>,
 ) -> anyhow::Result<fleet_pipeline::SyncResult> {
     println!(":: Synchronizing...");
     println!("   Target: {}", path);
@@ -266,6 +361,9 @@ pub async fn cmd_sync(
         max_threads: threads.clamp(1, 32),
         rate_limit_bytes: limit_mb.map(|mb| mb * 1024 * 1024),
         cache_root: cache_dir,
+        mirror_urls: Vec::new(),
+        progress_table: None,
+        dedup_roots,
     };
 
     let req = SyncRequest {
@@ -277,7 +375,18 @@ pub async fn cmd_sync(
     };
 
     let (tx, mut rx) = tokio::sync::mpsc::channel(100);
-    let engine_handle = tokio::spawn(async move { engine.plan_and_execute(&req, Some(tx)).await });
+    // Hashing modes run the per-mod streaming pipeline so downloads start as
+    // soon as the first mod is scanned instead of after the full tree hash.
+    // The phase-timed perf report needs discrete fetch/scan/diff/execute
+    // phases, so --perf-report keeps the batch pipeline; stat-only modes
+    // delegate to it internally anyway.
+    let engine_handle = tokio::spawn(async move {
+        if perf_report {
+            engine.plan_and_execute(&req, Some(tx)).await
+        } else {
+            engine.plan_and_execute_streaming(&req, Some(tx)).await
+        }
+    });
 
     let m = MultiProgress::new();
     let sty_main = ProgressStyle::with_template(
@@ -314,15 +423,89 @@ pub async fn cmd_sync(
                 files_done = files_done.saturating_add(1);
                 pb_main.set_message(format!("Downloading {}/{} files", files_done, files_total));
             }
+            DownloadEvent::ModCompleted { mod_name } => {
+                pb_main.println(format!("   {mod_name} complete"));
+            }
         }
     }
 
     let result = engine_handle.await??;
     pb_main.finish_with_message("Sync Complete");
 
+    if result.stats.files_linked > 0 {
+        println!(
+            ":: Deduplicated {} files ({}) from other profiles",
+            result.stats.files_linked,
+            format_size(result.stats.bytes_linked, DECIMAL)
+        );
+    }
+
+    if perf_report {
+        match &result.perf {
+            Some(report) => println!("{}", serde_json::to_string_pretty(report)?),
+            None => eprintln!(":: No perf report available for this sync mode"),
+        }
+    }
+
     Ok(result)
 }
 
+/// Launches a profile, reusing a cached resolved command when nothing changed.
+///
+/// The resolved command (mod list, translated paths, working dir) is persisted
+/// in `fleet.redb` keyed by profile ID and validated with a single stat of the
+/// mod root: adding/removing a mod directory or replacing repo.json both bump
+/// the directory mtime, so a stale cache resolves fresh. A warm launch is one
+/// redb read plus spawn — no repo.json parse, no directory walk.
+pub fn cmd_launch_profile(
+    profile_id: &str,
+    local_root: &Utf8PathBuf,
+    launcher: &fleet_infra::launcher::Launcher,
+    config_fingerprint: &str,
+) -> Result<()> {
+    use fleet_infra::launcher::{Launcher, ResolvedLaunchCommand};
+    use fleet_persistence::LaunchCacheEntry;
+
+    let dir_mtime = std::fs::metadata(local_root)
+        .ok()
+        .and_then(|m| m.modified().ok())
+        .and_then(|t| t.duration_since(std::time::UNIX_EPOCH).ok())
+        .map(|d| d.as_millis() as u64);
+
+    let store = RedbFleetDataStore;
+    if let (Some(dir_mtime), Ok(Some(entry))) =
+        (dir_mtime, store.load_launch_command(local_root, profile_id))
+    {
+        if entry.dir_mtime == dir_mtime && entry.config_fingerprint == config_fingerprint {
+            return Ok(Launcher::spawn_resolved(&ResolvedLaunchCommand {
+                program: entry.program,
+                args: entry.args,
+                working_dir: std::path::PathBuf::from(entry.working_dir),
+            })?);
+        }
+    }
+
+    let mods = resolve_mods_from_dir(local_root)?;
+    let cmd = launcher.resolve_command(mods)?;
+
+    // Cache best-effort: a read-only or busy database shouldn't block launch.
+    if let (Some(dir_mtime), Some(working_dir)) = (dir_mtime, cmd.working_dir.to_str()) {
+        let _ = store.store_launch_command(
+            local_root,
+            profile_id,
+            &LaunchCacheEntry {
+                dir_mtime,
+                config_fingerprint: config_fingerprint.to_string(),
+                program: cmd.program.clone(),
+                args: cmd.args.clone(),
+                working_dir: working_dir.to_string(),
+            },
+        );
+    }
+
+    Ok(Launcher::spawn_resolved(&cmd)?)
+}
+
 /// Helper: Resolve mod paths by reading repo.json from the target directory.
 pub fn resolve_mods_from_dir(local_root: &Utf8PathBuf) -> Result<Vec<Utf8PathBuf>> {
     let repo_json_path = local_root.join("repo.json");
@@ -1,5 +1,6 @@
 pub mod commands;
 pub mod profiles;
+pub mod serve;
 
 use clap::ValueEnum;
 use fleet_pipeline::sync::SyncMode;
@@ -44,6 +44,11 @@ enum Commands {
         path: Option<Utf8PathBuf>,
         #[arg(short, long, help = "Use settings from a named profile")]
         profile: Option<String>,
+        #[arg(
+            long,
+            help = "Keep running and re-check incrementally as files change"
+        )]
+        watch: bool,
     },
     Repair {
         #[arg(long, required_unless_present = "profile")]
@@ -68,6 +73,16 @@ enum Commands {
         limit_mb: Option<u64>,
         #[arg(long)]
         cache_dir: Option<Utf8PathBuf>,
+        #[arg(long, help = "Print a machine-readable JSON perf report after the sync")]
+        perf_report: bool,
+    },
+    /// Serve a mods directory as a Swifty-compatible repo over HTTP
+    Serve {
+        path: Utf8PathBuf,
+        #[arg(long, default_value = "0.0.0.0:8080")]
+        bind: String,
+        #[arg(long, default_value = "Fleet Repo", help = "Repo name published in repo.json")]
+        name: String,
     },
     Launch {
         #[arg(
@@ -152,14 +167,18 @@ async fn main() -> anyhow::Result<()> {
             };
             commands::cmd_check_for_updates(final_repo, final_path).await?;
         }
-        Commands::LocalCheck { path, profile } => {
+        Commands::LocalCheck {
+            path,
+            profile,
+            watch,
+        } => {
             let final_path = if let Some(p_name) = profile {
                 let (_repo, path) = resolve_profile(&p_name)?;
                 path
             } else {
                 path.unwrap()
             };
-            commands::cmd_local_check(final_path).await?;
+            commands::cmd_local_check(final_path, watch).await?;
         }
         Commands::Repair {
             repo,
@@ -181,13 +200,36 @@ async fn main() -> anyhow::Result<()> {
             threads,
             limit_mb,
             cache_dir,
+            perf_report,
         } => {
             let (final_repo, final_path) = if let Some(p_name) = profile {
                 resolve_profile(&p_name)?
             } else {
                 (repo.unwrap(), path.unwrap())
             };
-            commands::cmd_sync(final_repo, final_path, mode, threads, limit_mb, cache_dir).await?;
+            // Other profiles' roots feed cross-profile dedup: shared mods are
+            // hardlinked from an existing verified copy instead of downloaded.
+            let dedup_roots: Vec<Utf8PathBuf> = profiles::ProfileManager::new()
+                .list()
+                .unwrap_or_default()
+                .into_iter()
+                .map(|p| Utf8PathBuf::from(p.local_path))
+                .filter(|p| *p != final_path)
+                .collect();
+            commands::cmd_sync(
+                final_repo,
+                final_path,
+                mode,
+                threads,
+                limit_mb,
+                cache_dir,
+                perf_report,
+                dedup_roots,
+            )
+            .await?;
+        }
+        Commands::Serve { path, bind, name } => {
+            fleet_cli::serve::cmd_serve(path, bind, name).await?;
         }
         Commands::Launch {
             mods,
@@ -223,6 +265,9 @@ async fn main() -> anyhow::Result<()> {
                 }
             });
 
+            // Launch flags feed the cached-command fingerprint: different
+            // args or template must never reuse a cached resolve.
+            let config_fingerprint = format!("{args}\n{launch_template}");
             let launcher = Launcher::new("".to_string(), args, launch_template);
 
             let final_mods = if let Some(explicit_mods) = mods {
@@ -230,7 +275,13 @@ async fn main() -> anyhow::Result<()> {
             } else if let Some(p_name) = profile {
                 let mgr = profiles::ProfileManager::new();
                 let p = mgr.find(&p_name)?;
-                commands::resolve_mods_from_dir(&Utf8PathBuf::from(p.local_path))?
+                commands::cmd_launch_profile(
+                    &p.id,
+                    &Utf8PathBuf::from(p.local_path),
+                    &launcher,
+                    &config_fingerprint,
+                )?;
+                return Ok(());
             } else {
                 Vec::new()
             };
@@ -0,0 +1,447 @@
+//! Built-in repo server: one binary that scans a mods directory, keeps
+//! `repo.json` and per-mod `mod.srf` current via the filesystem watcher, and
+//! serves mod files over HTTP with Range support and checksum-validated
+//! caching.
+//!
+//! Manifests live in memory and are regenerated incrementally: the watcher
+//! reports which `@mod` directories changed and only those are re-hashed
+//! (through the same `ScanCache` the sync path uses, so unchanged files cost
+//! a stat). They are deliberately not written into the served tree — the
+//! scanner would hash a `mod.srf` on disk into the next manifest and chase
+//! its own tail.
+
+use std::collections::HashMap;
+use std::sync::{Arc, RwLock};
+use std::time::Duration;
+
+use anyhow::{Context, Result};
+use axum::body::Body;
+use axum::extract::State;
+use axum::http::{header, HeaderMap, StatusCode, Uri};
+use axum::response::{IntoResponse, Response};
+use axum::routing::get;
+use axum::Router;
+use camino::{Utf8Path, Utf8PathBuf};
+use fleet_core::formats::repo::{RepoModExternal, RepositoryExternal};
+use fleet_core::Mod;
+use fleet_persistence::{CacheUpsert, FleetDataStore, RedbFleetDataStore};
+use fleet_scanner::cache::ScanCache;
+use fleet_scanner::watch::RootWatcher;
+use fleet_scanner::{ScanCacheStore, ScanStrategy, Scanner, ScannerError};
+use tokio::io::{AsyncReadExt, AsyncSeekExt};
+
+/// How often accumulated watcher events are folded into a re-scan.
+const WATCH_POLL_INTERVAL: Duration = Duration::from_secs(2);
+/// Read size for streamed file responses.
+const STREAM_CHUNK_SIZE: usize = 256 * 1024;
+
+/// Everything a request handler needs, rebuilt wholesale on each re-scan so
+/// handlers never see a half-updated repo.
+struct RepoState {
+    repo_json: Arc<String>,
+    repo_checksum: String,
+    /// Mod name -> serialized SRF plus the mod checksum used as its ETag.
+    srfs: HashMap<String, (Arc<String>, String)>,
+    /// "mod/rel_path" (normalized lowercase) -> file checksum, for ETags.
+    file_checksums: HashMap<String, String>,
+}
+
+struct Shared {
+    root: Utf8PathBuf,
+    state: RwLock<Arc<RepoState>>,
+}
+
+/// `ScanCacheStore` backed by the served root's `fleet.redb`, mirroring the
+/// adapter the sync engine uses so publish scans share its cache format.
+struct RedbScanCacheStore {
+    root: Utf8PathBuf,
+    store: RedbFleetDataStore,
+}
+
+impl ScanCacheStore for RedbScanCacheStore {
+    fn load_mod_cache(&self, mod_name: &str) -> Result<ScanCache, ScannerError> {
+        let entries = match self.store.scan_cache_load_mod(&self.root, mod_name) {
+            Ok(e) => e,
+            Err(e) => {
+                tracing::warn!("Cache load failed for {mod_name}: {e}");
+                return Ok(ScanCache::default());
+            }
+        };
+        let mut cache = ScanCache::default();
+        for (rel_path, e) in entries {
+            cache.entries.insert(
+                rel_path,
+                fleet_scanner::cache::FileCacheEntry {
+                    mtime: e.mtime,
+                    size: e.size,
+                    checksum: e.checksum,
+                    fast_checksum: e.fast_checksum,
+                },
+            );
+        }
+        Ok(cache)
+    }
+
+    fn save_mod_cache(&self, mod_name: &str, cache: &ScanCache) -> Result<(), ScannerError> {
+        let mut upserts = Vec::with_capacity(cache.entries.len());
+        for (rel_path, e) in &cache.entries {
+            upserts.push(CacheUpsert {
+                rel_path: rel_path.clone(),
+                mtime: e.mtime,
+                size: e.size,
+                checksum: e.checksum.clone(),
+                fast_checksum: e.fast_checksum.clone(),
+            });
+        }
+        if let Err(e) = self
+            .store
+            .scan_cache_upsert_batch(&self.root, mod_name, &upserts)
+        {
+            tracing::warn!("Cache save failed for {mod_name}: {e}");
+        }
+        Ok(())
+    }
+}
+
+/// Builds the serve-ready repo state from the current mod set.
+fn build_state(repo_name: &str, mods: &HashMap<String, Mod>) -> Result<RepoState> {
+    let mut sorted: Vec<&Mod> = mods.values().collect();
+    sorted.sort_by(|a, b| a.name.cmp(&b.name));
+
+    // Repo checksum covers each mod's name and checksum, same shape as the
+    // per-mod checksum over its files.
+    let mut hasher = md5::Context::new();
+    for m in &sorted {
+        hasher.consume(m.checksum.as_bytes());
+        hasher.consume(m.name.as_bytes());
+    }
+    let repo_checksum = format!("{:X}", hasher.finalize());
+
+    let repo = RepositoryExternal {
+        repo_name: repo_name.to_string(),
+        checksum: repo_checksum.clone(),
+        required_mods: sorted
+            .iter()
+            .map(|m| RepoModExternal {
+                mod_name: m.name.clone(),
+                checksum: m.checksum.clone(),
+                enabled: true,
+            })
+            .collect(),
+        optional_mods: Vec::new(),
+        mirrors: Vec::new(),
+    };
+
+    let mut srfs = HashMap::with_capacity(sorted.len());
+    let mut file_checksums = HashMap::new();
+    for m in &sorted {
+        let srf = serde_json::to_string(m).context("serialize mod.srf")?;
+        srfs.insert(m.name.clone(), (Arc::new(srf), m.checksum.clone()));
+        for f in &m.files {
+            file_checksums.insert(
+                format!("{}/{}", m.name, f.path).to_lowercase(),
+                f.checksum.clone(),
+            );
+        }
+    }
+
+    Ok(RepoState {
+        repo_json: Arc::new(serde_json::to_string_pretty(&repo).context("serialize repo.json")?),
+        repo_checksum,
+        srfs,
+        file_checksums,
+    })
+}
+
+fn scan_all(root: &Utf8Path, cache_store: Arc<dyn ScanCacheStore>) -> Result<HashMap<String, Mod>> {
+    let manifest = Scanner::scan_directory(
+        root,
+        ScanStrategy::SmartCache,
+        None,
+        Some(cache_store),
+        None,
+    )?;
+    Ok(manifest.mods.into_iter().map(|m| (m.name.clone(), m)).collect())
+}
+
+pub async fn cmd_serve(root: Utf8PathBuf, bind: String, repo_name: String) -> Result<()> {
+    let listener = tokio::net::TcpListener::bind(&bind)
+        .await
+        .with_context(|| format!("Failed to bind {bind}"))?;
+    run(root, listener, repo_name).await
+}
+
+/// Scan-and-serve core behind [`cmd_serve`]; takes a bound listener so tests
+/// can serve on an ephemeral port.
+pub async fn run(
+    root: Utf8PathBuf,
+    listener: tokio::net::TcpListener,
+    repo_name: String,
+) -> Result<()> {
+    println!(":: Serving repo from {}", root);
+
+    let cache_store: Arc<dyn ScanCacheStore> = Arc::new(RedbScanCacheStore {
+        root: root.clone(),
+        store: RedbFleetDataStore,
+    });
+
+    // The watcher starts before the initial scan so changes racing the scan
+    // surface as dirty mods instead of being missed.
+    let watcher = RootWatcher::new(&root)?;
+
+    let scan_root = root.clone();
+    let scan_cache = cache_store.clone();
+    let mut mods =
+        tokio::task::spawn_blocking(move || scan_all(&scan_root, scan_cache)).await??;
+    println!(
+        ":: Initial scan complete: {} mods, {} files",
+        mods.len(),
+        mods.values().map(|m| m.files.len()).sum::<usize>()
+    );
+
+    let shared = Arc::new(Shared {
+        root: root.clone(),
+        state: RwLock::new(Arc::new(build_state(&repo_name, &mods)?)),
+    });
+
+    // Incremental publish loop: drain the watcher, re-hash only dirty mods,
+    // and swap in a fresh state snapshot.
+    let publisher = shared.clone();
+    tokio::spawn(async move {
+        let mut ticker = tokio::time::interval(WATCH_POLL_INTERVAL);
+        loop {
+            ticker.tick().await;
+            let delta = watcher.drain();
+            if !delta.lost_track && delta.dirty_mods.is_empty() {
+                continue;
+            }
+
+            let result = if delta.lost_track {
+                let scan_root = publisher.root.clone();
+                let scan_cache = cache_store.clone();
+                tokio::task::spawn_blocking(move || scan_all(&scan_root, scan_cache))
+                    .await
+                    .map_err(anyhow::Error::from)
+                    .and_then(|r| r)
+                    .map(|full| {
+                        mods = full;
+                    })
+            } else {
+                let names: Vec<String> = delta.dirty_mods.iter().cloned().collect();
+                let scan_root = publisher.root.clone();
+                let scan_cache = cache_store.clone();
+                let rescan_names = names.clone();
+                tokio::task::spawn_blocking(move || {
+                    Scanner::scan_mods(
+                        &scan_root,
+                        &rescan_names,
+                        ScanStrategy::SmartCache,
+                        None,
+                        Some(scan_cache),
+                        None,
+                    )
+                })
+                .await
+                .map_err(anyhow::Error::from)
+                .and_then(|r| r.map_err(anyhow::Error::from))
+                .map(|rescanned| {
+                    // Dirty mods whose directory vanished drop out of the repo.
+                    for name in &names {
+                        mods.remove(name);
+                    }
+                    for m in rescanned {
+                        mods.insert(m.name.clone(), m);
+                    }
+                })
+            };
+
+            match result.and_then(|()| build_state(&repo_name, &mods)) {
+                Ok(state) => {
+                    println!(
+                        ":: Republished: {} mods (checksum {})",
+                        state.srfs.len(),
+                        state.repo_checksum
+                    );
+                    *publisher.state.write().unwrap() = Arc::new(state);
+                }
+                Err(e) => tracing::error!("Republish failed, serving previous state: {e}"),
+            }
+        }
+    });
+
+    let app = Router::new().fallback(get(handle)).with_state(shared);
+    println!(":: Listening on http://{}", listener.local_addr()?);
+    axum::serve(listener, app).await?;
+    Ok(())
+}
+
+async fn handle(State(shared): State<Arc<Shared>>, uri: Uri, headers: HeaderMap) -> Response {
+    let Ok(path) = percent_encoding::percent_decode_str(uri.path()).decode_utf8() else {
+        return StatusCode::BAD_REQUEST.into_response();
+    };
+    let path = path.trim_start_matches('/');
+
+    let state = shared.state.read().unwrap().clone();
+
+    if path == "repo.json" {
+        return manifest_response(&state.repo_json, &state.repo_checksum, &headers);
+    }
+    if let Some(mod_name) = path.strip_suffix("/mod.srf") {
+        return match state.srfs.get(mod_name) {
+            Some((srf, checksum)) => manifest_response(srf, checksum, &headers),
+            None => StatusCode::NOT_FOUND.into_response(),
+        };
+    }
+
+    // Only files inside top-level `@mod` directories are repo content; any
+    // traversal component rejects the request outright.
+    if !path.starts_with('@')
+        || path
+            .split('/')
+            .any(|c| c.is_empty() || c == "." || c == "..")
+    {
+        return StatusCode::NOT_FOUND.into_response();
+    }
+
+    let etag = state.file_checksums.get(&path.to_lowercase()).cloned();
+    serve_file(&shared.root.join(path), etag, &headers).await
+}
+
+/// In-memory manifests revalidate on every request (they change whenever a
+/// mod is republished), so the checksum ETag does the caching work.
+fn manifest_response(body: &Arc<String>, checksum: &str, headers: &HeaderMap) -> Response {
+    let etag = format!("\"{checksum}\"");
+    if if_none_match_hits(headers, &etag) {
+        return not_modified(etag);
+    }
+    (
+        [
+            (header::ETAG, etag),
+            (header::CACHE_CONTROL, "public, no-cache".to_string()),
+            (header::CONTENT_TYPE, "application/json".to_string()),
+        ],
+        body.as_str().to_owned(),
+    )
+        .into_response()
+}
+
+fn if_none_match_hits(headers: &HeaderMap, etag: &str) -> bool {
+    headers
+        .get(header::IF_NONE_MATCH)
+        .and_then(|v| v.to_str().ok())
+        .is_some_and(|v| v.split(',').any(|c| c.trim() == etag || c.trim() == "*"))
+}
+
+fn not_modified(etag: String) -> Response {
+    (StatusCode::NOT_MODIFIED, [(header::ETAG, etag)]).into_response()
+}
+
+/// A single `bytes=start-end` range resolved against the file length.
+fn parse_range(headers: &HeaderMap, len: u64) -> Result<Option<(u64, u64)>, ()> {
+    let Some(raw) = headers.get(header::RANGE).and_then(|v| v.to_str().ok()) else {
+        return Ok(None);
+    };
+    let Some(spec) = raw.strip_prefix("bytes=") else {
+        return Ok(None); // Unknown unit: ignore per RFC 9110, serve the whole file.
+    };
+    if spec.contains(',') {
+        // Multipart ranges are never sent by our downloader; full response.
+        return Ok(None);
+    }
+    let Some((start, end)) = spec.split_once('-') else {
+        return Err(());
+    };
+    let (start, end) = match (start, end) {
+        // bytes=-N : final N bytes.
+        ("", suffix) => {
+            let n: u64 = suffix.parse().map_err(|_| ())?;
+            if n == 0 {
+                return Err(());
+            }
+            (len.saturating_sub(n), len.saturating_sub(1))
+        }
+        (start, "") => (start.parse().map_err(|_| ())?, len.saturating_sub(1)),
+        (start, end) => (start.parse().map_err(|_| ())?, end.parse().map_err(|_| ())?),
+    };
+    if start > end || start >= len {
+        return Err(());
+    }
+    Ok(Some((start, end.min(len.saturating_sub(1)))))
+}
+
+async fn serve_file(fs_path: &Utf8Path, etag: Option<String>, headers: &HeaderMap) -> Response {
+    let meta = match tokio::fs::metadata(fs_path).await {
+        Ok(m) if m.is_file() => m,
+        _ => return StatusCode::NOT_FOUND.into_response(),
+    };
+    let len = meta.len();
+
+    // Content is addressed by checksum, so the ETag alone decides freshness.
+    let etag = etag.map(|c| format!("\"{c}\""));
+    if let Some(etag) = &etag {
+        if if_none_match_hits(headers, etag) {
+            return not_modified(etag.clone());
+        }
+    }
+
+    let range = match parse_range(headers, len) {
+        Ok(r) => r,
+        Err(()) => {
+            return (
+                StatusCode::RANGE_NOT_SATISFIABLE,
+                [(header::CONTENT_RANGE, format!("bytes */{len}"))],
+            )
+                .into_response();
+        }
+    };
+    let (start, end) = range.unwrap_or((0, len.saturating_sub(1)));
+    let body_len = if len == 0 { 0 } else { end - start + 1 };
+
+    let mut file = match tokio::fs::File::open(fs_path).await {
+        Ok(f) => f,
+        Err(_) => return StatusCode::NOT_FOUND.into_response(),
+    };
+    if start > 0 {
+        if file.seek(std::io::SeekFrom::Start(start)).await.is_err() {
+            return StatusCode::INTERNAL_SERVER_ERROR.into_response();
+        }
+    }
+
+    // Stream in fixed chunks straight from the file handle; nothing is
+    // buffered beyond one chunk regardless of file size.
+    let stream = futures::stream::try_unfold(
+        (file, body_len),
+        |(mut file, remaining)| async move {
+            if remaining == 0 {
+                return Ok::<_, std::io::Error>(None);
+            }
+            let take = remaining.min(STREAM_CHUNK_SIZE as u64) as usize;
+            let mut buf = vec![0u8; take];
+            let n = file.read(&mut buf).await?;
+            if n == 0 {
+                return Ok(None);
+            }
+            buf.truncate(n);
+            Ok(Some((
+                bytes::Bytes::from(buf),
+                (file, remaining - n as u64),
+            )))
+        },
+    );
+
+    let mut builder = Response::builder()
+        .header(header::ACCEPT_RANGES, "bytes")
+        .header(header::CONTENT_LENGTH, body_len)
+        .header(header::CACHE_CONTROL, "public, no-cache");
+    if let Some(etag) = etag {
+        builder = builder.header(header::ETAG, etag);
+    }
+    if range.is_some() {
+        builder = builder
+            .status(StatusCode::PARTIAL_CONTENT)
+            .header(header::CONTENT_RANGE, format!("bytes {start}-{end}/{len}"));
+    }
+    builder
+        .body(Body::from_stream(stream))
+        .unwrap_or_else(|_| StatusCode::INTERNAL_SERVER_ERROR.into_response())
+}
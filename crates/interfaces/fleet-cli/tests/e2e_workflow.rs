@@ -100,6 +100,8 @@ async fn full_user_lifecycle_workflow() {
         4,
         None,
         None,
+        false,
+        Vec::new(),
     )
     .await
     .expect("Phase 1 sync failed");
@@ -160,6 +162,8 @@ async fn full_user_lifecycle_workflow() {
         4,
         None,
         None,
+        false,
+        Vec::new(),
     )
     .await
     .expect("Phase 5 repair failed");
@@ -0,0 +1,24 @@
+use camino::Utf8PathBuf;
+use fleet_cli::{commands, CliScanStrategy};
+
+/// `scan --output` streams mods into the file as they finish; the result
+/// must still parse as a normal `Manifest`.
+#[tokio::test]
+async fn streamed_scan_output_parses_as_manifest() {
+    let dir = tempfile::tempdir().unwrap();
+    let root = Utf8PathBuf::from_path_buf(dir.path().to_path_buf()).unwrap();
+    std::fs::create_dir_all(root.join("@streamed/addons")).unwrap();
+    std::fs::write(root.join("@streamed/addons/data.bin"), b"payload").unwrap();
+
+    let out = root.join("manifest.json");
+    commands::cmd_scan(root.clone(), Some(out.clone()), CliScanStrategy::Force)
+        .await
+        .unwrap();
+
+    let manifest: fleet_core::Manifest =
+        serde_json::from_str(&std::fs::read_to_string(&out).unwrap()).unwrap();
+    assert_eq!(manifest.version, "1.0");
+    assert_eq!(manifest.mods.len(), 1);
+    assert_eq!(manifest.mods[0].name, "@streamed");
+    assert_eq!(manifest.mods[0].files[0].path, "addons/data.bin");
+}